@@ -7,14 +7,26 @@
 
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <limits.h>
+#include <poll.h>
 #include <signal.h>
 #include <stdarg.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <spawn.h>
+#include <sys/file.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
+#include <sys/un.h>
 #include <sys/wait.h>
 #include <time.h>
 #include <unistd.h>
@@ -22,6 +34,10 @@
 
 #include "lang/lang.h"
 
+static int str_eq(const char* a, const char* b) {
+    return strcmp(a, b) == 0;
+}
+
 typedef enum i0_log_type {
     I0_LOG_INFO = 0,
     I0_LOG_GOOD,
@@ -55,14 +71,142 @@ static char* const i0_log_type_color[I0_MAX_LOG_LEVEL - I0_MIN_LOG_LEVEL + 1] =
     "\033[1;31m", // I0_LOG_CRITICAL   -> bright red
 };
 
-// va_list is a dark magic for compiler so i use __VA_ARGS__
+static char* const i0_log_type_name[I0_MAX_LOG_LEVEL - I0_MIN_LOG_LEVEL + 1] = {
+    "info",
+    "good",
+    "bad",
+    "start",
+    "stop",
+    "warning",
+    "critical"
+};
+
+// syslog priorities for /dev/kmsg
+static const int i0_log_type_kmsg[I0_MAX_LOG_LEVEL - I0_MIN_LOG_LEVEL + 1] = {
+    6, // info
+    6, // info
+    5, // notice
+    6, // info
+    6, // info
+    4, // warning
+    2  // crit
+};
+
+typedef enum i0_log_format {
+    I0_LOG_FORMAT_AUTO = 0,
+    I0_LOG_FORMAT_PLAIN,
+    I0_LOG_FORMAT_COLOR,
+    I0_LOG_FORMAT_JSON,
+    I0_LOG_FORMAT_KMSG
+} i0_log_format;
+
+// room for any $I0_LOG value, it is passed on to supervisor workers
+#define I0_LOG_NAME_MAX 16
+
+static i0_log_format i0_log_fmt = I0_LOG_FORMAT_AUTO;
+static int i0_log_color[2]; // stdout, stderr
+static int i0_log_kmsg = -1;
+
+// $I0_LOG picks plain, color, json or kmsg. by default colors are used on
+// a terminal only and pid 1 logs to the kernel ring buffer
+static void i0_log_init() {
+    const char* env = getenv("I0_LOG");
+    if (env && str_eq(env, "plain")) i0_log_fmt = I0_LOG_FORMAT_PLAIN;
+    if (env && str_eq(env, "color")) i0_log_fmt = I0_LOG_FORMAT_COLOR;
+    if (env && str_eq(env, "json")) i0_log_fmt = I0_LOG_FORMAT_JSON;
+    if (env && str_eq(env, "kmsg")) i0_log_fmt = I0_LOG_FORMAT_KMSG;
+    if (i0_log_fmt == I0_LOG_FORMAT_AUTO && getpid() == 1) i0_log_fmt = I0_LOG_FORMAT_KMSG;
+
+    if (i0_log_fmt == I0_LOG_FORMAT_KMSG) {
+        i0_log_kmsg = open("/dev/kmsg", O_WRONLY | O_CLOEXEC);
+        if (i0_log_kmsg < 0) i0_log_fmt = I0_LOG_FORMAT_PLAIN;
+    }
+
+    for (int i = 0; i < 2; i++) {
+        i0_log_color[i] = i0_log_fmt == I0_LOG_FORMAT_COLOR
+            || (i0_log_fmt == I0_LOG_FORMAT_AUTO && isatty(i + 1));
+    }
+}
+
+static size_t i0_log_json_escape(char* dest, const size_t size, const char* src) {
+    size_t n = 0;
+    for (; *src && n + 7 < size; src++) {
+        const unsigned char c = (unsigned char)*src;
+        if (c == '"' || c == '\\') {
+            dest[n++] = '\\';
+            dest[n++] = (char)c;
+        }
+        else if (c < 0x20) {
+            n += (size_t)snprintf(dest + n, size - n, "\\u%04x", c);
+        }
+        else {
+            dest[n++] = (char)c;
+        }
+    }
+    return n;
+}
+
+// the whole record is formatted first and goes out in a single write(),
+// so lines of parallel workers never interleave
+static void i0_log_write(const i0_log_type level, const char* format, ...) {
+    char msg[2048];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(msg, sizeof(msg), format, args);
+    va_end(args);
+
+    FILE* stream = level < I0_LOG_WARNING ? stdout : stderr;
+    int fd = fileno(stream);
+    char buf[4608];
+    int len;
+
+    switch (i0_log_fmt) {
+    case I0_LOG_FORMAT_JSON: {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        char escaped[sizeof(msg) * 2];
+        escaped[i0_log_json_escape(escaped, sizeof(escaped), msg)] = '\0';
+        len = snprintf(
+            buf, sizeof(buf),
+            "{\"ts\":%lld.%03ld,\"level\":\"%s\",\"pid\":%d,\"msg\":\"%s\"}\n",
+            (long long)ts.tv_sec, ts.tv_nsec / 1000000,
+            i0_log_type_name[level], (int)getpid(), escaped
+        );
+        break;
+    }
+    case I0_LOG_FORMAT_KMSG:
+        fd = i0_log_kmsg;
+        len = snprintf(buf, sizeof(buf), "<%d>i0: [%c] %s\n", i0_log_type_kmsg[level], i0_log_type_char[level], msg);
+        break;
+    default:
+        if (i0_log_color[stream == stderr]) {
+            len = snprintf(buf, sizeof(buf), "%s[%c] %s\033[0m\n", i0_log_type_color[level], i0_log_type_char[level], msg);
+        }
+        else {
+            len = snprintf(buf, sizeof(buf), "[%c] %s\n", i0_log_type_char[level], msg);
+        }
+        break;
+    }
+
+    if (len < 0) return;
+    if ((size_t)len >= sizeof(buf)) {
+        len = sizeof(buf) - 1;
+        buf[len - 1] = '\n';
+    }
+
+    // anything printed with stdio before has to come first
+    fflush(stream);
+    for (const char* p = buf; len > 0;) {
+        const ssize_t n = write(fd, p, (size_t)len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        p += n;
+        len -= (int)n;
+    }
+}
+
 #define i0_log(level, ...) do { \
-    FILE* _stream = (level) < I0_LOG_WARNING ? stdout : stderr; \
-    fputs(i0_log_type_color[level], _stream); \
-    fprintf(_stream, "[%c] ", i0_log_type_char[level]); \
-    fprintf(_stream, __VA_ARGS__); \
-    fputs("\033[0m\n", _stream); \
-    fflush(_stream); \
+    i0_log_write(level, __VA_ARGS__); \
     if ((level) == I0_LOG_CRITICAL) _exit(EXIT_FAILURE); \
 } while(0)
 
@@ -70,36 +214,70 @@ static void i0_perror(const char* prefix) {
     i0_log(I0_LOG_CRITICAL, "%s: %s", prefix, strerror(errno));
 }
 
+// i0 log <level> <message>, how task scripts print like i0 does
+static int i0_log_command(const int argc, const char* argv[]) {
+    int level = I0_MIN_LOG_LEVEL;
+    while (argc == 2 && level <= I0_MAX_LOG_LEVEL && !str_eq(i0_log_type_name[level], argv[0])) level++;
+    if (argc != 2 || level > I0_MAX_LOG_LEVEL) {
+        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_LOG_USAGE]);
+    }
+    i0_log((i0_log_type)level, "%s", argv[1]);
+    return EXIT_SUCCESS;
+}
+
 typedef char i0_string[4096];
 
 #define I0_MAIN_SCRIPT "#!/bin/sh\n" \
     "exec %s\n"
 
+// i0 runs these in the task dir with $I0_RUNTIME_DIR set to the task's
+// runtime dir, where the pid file lives. they report through `i0 log`
+// ($I0_BIN is the i0 running them), so $I0_LOG applies to them as well
+
 #define I0_START_SCRIPT "#!/bin/sh\n" \
-    "[ -f pid ] && pid=$(cat pid) && [ -d \"/proc/$pid\" ] && echo \"%s\" && exit\n" \
+    "i0=\"${I0_BIN:-i0}\"\n" \
+    "pidfile=\"$I0_RUNTIME_DIR/pid\"\n" \
+    "[ -f \"$pidfile\" ] && pid=$(cat \"$pidfile\") && [ -d \"/proc/$pid\" ] && \"$i0\" log warning \"%s\" && exit\n" \
     "./main &\n" \
-    "echo $! > pid\n" \
-    "echo \"%s\"\n"
+    "echo $! > \"$pidfile\"\n" \
+    "\"$i0\" log start \"%s\"\n"
 
 #define I0_STOP_SCRIPT "#!/bin/sh\n" \
-    "[ ! -f pid ] && echo \"%s\" && exit\n" \
-    "pid=$(cat pid)\n" \
-    "[ ! -d \"/proc/$pid\" ] && echo \"%s\" && exit\n" \
+    "i0=\"${I0_BIN:-i0}\"\n" \
+    "pidfile=\"$I0_RUNTIME_DIR/pid\"\n" \
+    "[ ! -f \"$pidfile\" ] && \"$i0\" log warning \"%s\" && exit\n" \
+    "pid=$(cat \"$pidfile\")\n" \
+    "[ ! -d \"/proc/$pid\" ] && \"$i0\" log warning \"%s\" && exit\n" \
     "kill -KILL \"$pid\"\n" \
-    "rm -f pid\n" \
-    "echo \"%s\"\n"
+    "rm -f \"$pidfile\"\n" \
+    "\"$i0\" log stop \"%s\"\n"
 
 #define I0_STATUS_SCRIPT "#!/bin/sh\n" \
-    "[ -e enabled ] && echo \"%s\"\n" \
-    "[ -f description ] && printf \"%s\\n\" \"$(cat description)\"\n" \
-    "[ ! -f pid ] && echo \"%s\" && exit\n" \
-    "pid=$(cat pid)\n" \
-    "[ ! -d \"/proc/$pid\" ] && echo \"%s\" && exit\n" \
-    "echo \"%s\"\n" \
-    "echo \"%s\"\n"
+    "i0=\"${I0_BIN:-i0}\"\n" \
+    "pidfile=\"$I0_RUNTIME_DIR/pid\"\n" \
+    "[ -e enabled ] && \"$i0\" log good \"%s\"\n" \
+    "[ -f description ] && \"$i0\" log info \"%s: $(cat description)\"\n" \
+    "[ ! -f \"$pidfile\" ] && \"$i0\" log bad \"%s\" && exit\n" \
+    "pid=$(cat \"$pidfile\")\n" \
+    "[ ! -d \"/proc/$pid\" ] && \"$i0\" log bad \"%s\" && exit\n" \
+    "\"$i0\" log good \"%s\"\n" \
+    "\"$i0\" log good \"%s\"\n"
+
+// seconds, per task overridable with <name>.timeout files
+#define I0_KILL_TIMEOUT 10
+#define I0_READY_TIMEOUT 30
+#define I0_SCRIPT_TIMEOUT 90
+
+// without a healthcheck a task is ready once it survived this long (ms)
+#define I0_READY_GRACE 200
 
 #define I0_LOCAL_TASKS_DIR "/.config/i0/tasks/"
 #define I0_PUBLIC_TASKS_DIR "/etc/i0/tasks/"
+#define I0_CGROUP_DIR "/sys/fs/cgroup/i0/"
+#define I0_PUBLIC_RUNTIME_DIR "/run/i0/"
+#define I0_RUNTIME_TASKS_DIR "tasks/"
+#define I0_LOCAL_EVENTS_DIR "/.local/state/i0/events/"
+#define I0_PUBLIC_EVENTS_DIR "/var/log/i0/events/"
 
 // =========================================== //
 // work with processes                         //
@@ -117,21 +295,125 @@ static int is_process_alive(const pid_t pid) {
     return kill(pid, 0) == 0 || errno == EPERM;
 }
 
-extern char** environ;
+// as root on cgroup v2 every task gets its own cgroup, so a process can be
+// traced back to its task whatever it does to its parent or environment
+static int i0_cgroup_path(const char* task, const char* file, i0_string path) {
+    if (geteuid() != 0 || access("/sys/fs/cgroup/cgroup.controllers", F_OK) != 0) return -1;
+    // an empty task is the i0 cgroup itself
+    const int n = task[0]
+        ? snprintf(path, sizeof(i0_string), I0_CGROUP_DIR "%s/%s", task, file)
+        : snprintf(path, sizeof(i0_string), I0_CGROUP_DIR "%s", file);
+    return n < 0 || n >= (int)sizeof(i0_string) ? -1 : 0;
+}
 
-static void i0_run_wait(const char* path) {
-    pid_t pid;
-    char* argv[] = { (char*)path, NULL };
+static void i0_cgroup_join(const char* task) {
+    i0_string path;
+    if (i0_cgroup_path(task, "", path) != 0) return;
+    mkdir(I0_CGROUP_DIR, 0755);
+    mkdir(path, 0755);
+
+    i0_cgroup_path(task, "cgroup.procs", path);
+    const int fd = open(path, O_WRONLY | O_CLOEXEC);
+    if (fd < 0) return;
+    if (write(fd, "0", 1) != 1) {
+        // not fatal, the task just stays in our cgroup
+    }
+    close(fd);
+}
+
+// see the fd store section
+static void i0_fdstore_inherit(const char* task);
+
+// runs in a freshly forked child right before exec. the supervisor blocks
+// signals for its signalfd and children must not inherit that
+static void i0_child_exec(const char* path, const char* task) {
+    sigset_t set;
+    sigemptyset(&set);
+    sigprocmask(SIG_SETMASK, &set, NULL);
+
+    if (task) {
+        setenv("I0_TASK", task, 1);
+        i0_cgroup_join(task);
+        i0_fdstore_inherit(task);
+    }
+    safe_execlp(path, path, NULL);
+}
+
+static int i0_pidfd_open(const pid_t pid) {
+#ifdef SYS_pidfd_open
+    return (int)syscall(SYS_pidfd_open, pid, 0);
+#else
+    (void)pid;
+    errno = ENOSYS;
+    return -1;
+#endif
+}
 
-    if (posix_spawn(&pid, path, NULL, NULL, argv, environ) != 0) {
-        i0_perror("posix_spawn()");
+static void i0_sleep_ms(const int ms) {
+    struct timespec ts = { .tv_sec = ms / 1000, .tv_nsec = (long)(ms % 1000) * 1000000 };
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) ;
+}
+
+// waits up to timeout_ms for any process to exit, 1 if it did.
+// a child of ours is reaped so it does not linger as a zombie, its wait
+// status goes to status if that is not NULL
+static int i0_pid_wait(const pid_t pid, const int timeout_ms, int* status) {
+    int exited = 0;
+    const int fd = i0_pidfd_open(pid);
+
+    if (fd >= 0) {
+        struct pollfd pfd = { .fd = fd, .events = POLLIN };
+        int ret;
+        while ((ret = poll(&pfd, 1, timeout_ms)) < 0 && errno == EINTR) ;
+        close(fd);
+        exited = ret > 0;
+    }
+    else if (errno == ESRCH) {
+        exited = 1;
+    }
+    else {
+        // kernel without pidfd
+        for (int waited = 0;; waited += 10) {
+            if (waitpid(pid, status, WNOHANG) == pid || !is_process_alive(pid)) {
+                exited = 1;
+                break;
+            }
+            if (waited >= timeout_ms) break;
+            i0_sleep_ms(10);
+        }
     }
 
+    if (exited) waitpid(pid, status, WNOHANG);
+    return exited;
+}
+
+// SIGTERM first and SIGKILL if the process is still there after timeout
+// seconds. returns the signal that did it, -1 with errno if none could be sent
+static int i0_kill_wait(const pid_t pid, const long timeout) {
+    if (kill(pid, SIGTERM) != 0) return -1;
+    if (i0_pid_wait(pid, (int)(timeout * 1000), NULL)) return SIGTERM;
+
+    if (kill(pid, SIGKILL) != 0) return errno == ESRCH ? SIGTERM : -1;
+    i0_pid_wait(pid, 1000, NULL);
+    return SIGKILL;
+}
+
+// runs a script in its own process group and kills the whole group once
+// it takes longer than timeout milliseconds. task is set for scripts that
+// start the task and so belong to it
+static int i0_run(const char* path, const char* task, const long timeout) {
+    pid_t pid;
+    fork_and_do(pid, (setpgid(0, 0), i0_child_exec(path, task)), setpgid(pid, pid));
+
     int status = 0;
-    waitpid(pid, &status, 0);
-    if (status != 0) {
-        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_ERROR_START_FAIL]);
+    if (i0_pid_wait(pid, (int)timeout, &status)) return status;
+
+    kill(-pid, SIGKILL);
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) i0_perror("waitpid()");
     }
+    i0_log(I0_LOG_WARNING, i0_lang[I0_LANG_SCRIPT_TIMEOUT], path, (timeout + 999) / 1000);
+    return status;
 }
 
 // =========================================== //
@@ -145,17 +427,13 @@ static void i0_string_append(char* dest, size_t dest_size, const char* suff, siz
     memcpy(dest + dest_size, suff, suff_size);
 }
 
-static int str_eq(const char* a, const char* b) {
-    return strcmp(a, b) == 0;
-}
-
 #define conststrlen(s) (sizeof(s) - 1)
 
 // =========================================== //
 // path work                                   //
 // =========================================== //
 
-static void i0_get_local_tasks_dir(i0_string path) {
+static void i0_get_home_subdir(i0_string path, const char* sub, const size_t sub_len) {
     const char* home = getenv("HOME");
     if (home == NULL) i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_ERROR_NO_HOME]);
 
@@ -164,7 +442,11 @@ static void i0_get_local_tasks_dir(i0_string path) {
 
     // you are a weird person if '/' is your home
     if (len < 2 || path[len - 1] == '/') len--;
-    i0_string_append(path, len, I0_LOCAL_TASKS_DIR, conststrlen(I0_LOCAL_TASKS_DIR) + 1);
+    i0_string_append(path, len, sub, sub_len + 1);
+}
+
+static void i0_get_local_tasks_dir(i0_string path) {
+    i0_get_home_subdir(path, I0_LOCAL_TASKS_DIR, conststrlen(I0_LOCAL_TASKS_DIR));
 }
 
 static void i0_get_system_tasks_dir(i0_string path) {
@@ -180,6 +462,80 @@ static void i0_get_tasks_dir(i0_string path) {
     }
 }
 
+// things that only live as long as the system is up
+// pids must not outlive a reboot, so users get $XDG_RUNTIME_DIR or the
+// /run/user/<uid> it usually points to, never something under $HOME
+static void i0_get_runtime_dir(i0_string path) {
+    const char* xdg = getenv("XDG_RUNTIME_DIR");
+    if (geteuid() == 0) {
+        i0_string_append(path, 0, I0_PUBLIC_RUNTIME_DIR, conststrlen(I0_PUBLIC_RUNTIME_DIR) + 1);
+        return;
+    }
+
+    char run_user[32];
+    if (!xdg || *xdg != '/') {
+        snprintf(run_user, sizeof(run_user), "/run/user/%u", (unsigned)geteuid());
+        struct stat st;
+        if (stat(run_user, &st) != 0 || !S_ISDIR(st.st_mode)) i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_ERROR_NO_RUNTIME_DIR]);
+        xdg = run_user;
+    }
+    const size_t len = strlen(xdg);
+    i0_string_append(path, 0, xdg, len);
+    i0_string_append(path, len, "/i0/", conststrlen("/i0/") + 1);
+}
+
+// <runtime dir>/tasks/<task>/<name>: pid, lock and last exit status, so
+// starting and stopping never writes to the tasks dir. tasks get a dir of
+// their own so none of them can clash with events/ or the supervisor's files
+static void i0_get_task_runtime_file(i0_string path, const char* task, const char* name) {
+    i0_get_runtime_dir(path);
+    size_t len = strlen(path);
+    i0_string_append(path, len, I0_RUNTIME_TASKS_DIR, conststrlen(I0_RUNTIME_TASKS_DIR));
+    len += conststrlen(I0_RUNTIME_TASKS_DIR);
+    i0_string_append(path, len, task, strlen(task));
+    len += strlen(task);
+    i0_string_append(path, len, "/", 1);
+    i0_string_append(path, len + 1, name, strlen(name) + 1);
+}
+
+// start/stop scripts generated before the pid file moved still keep it as
+// ./pid in the task dir. that one is used while the runtime one is missing
+static void i0_get_task_pid_file(i0_string path, const char* task) {
+    i0_get_task_runtime_file(path, task, "pid");
+    if (access(path, F_OK) == 0) return;
+
+    i0_string legacy;
+    i0_get_tasks_dir(legacy);
+    const size_t len = strlen(legacy);
+    i0_string_append(legacy, len, task, strlen(task));
+    i0_string_append(legacy, len + strlen(task), "/pid", conststrlen("/pid") + 1);
+    if (access(legacy, F_OK) == 0) memcpy(path, legacy, sizeof(i0_string));
+}
+
+// files next to the tasks dir, e.g. /etc/i0/<name>
+static void i0_get_config_file(i0_string path, const char* name) {
+    i0_get_tasks_dir(path);
+    const size_t len = strlen(path) - conststrlen("tasks/");
+    i0_string_append(path, len, name, strlen(name) + 1);
+}
+
+// the journal only outlives a reboot if its persistent dir was created by
+// hand, otherwise it stays in the runtime dir with everything else
+static void i0_get_events_dir(i0_string path) {
+    if (geteuid() == 0) {
+        i0_string_append(path, 0, I0_PUBLIC_EVENTS_DIR, conststrlen(I0_PUBLIC_EVENTS_DIR) + 1);
+    }
+    else {
+        i0_get_home_subdir(path, I0_LOCAL_EVENTS_DIR, conststrlen(I0_LOCAL_EVENTS_DIR));
+    }
+
+    struct stat st;
+    if (stat(path, &st) == 0 && S_ISDIR(st.st_mode)) return;
+
+    i0_get_runtime_dir(path);
+    i0_string_append(path, strlen(path), "events/", conststrlen("events/") + 1);
+}
+
 // =========================================== //
 // directory work                              //
 // =========================================== //
@@ -207,6 +563,20 @@ static void mkdir_p(i0_string path) {
     }
 }
 
+// same as mkdir_p() but reports failure instead of dying
+static int try_mkdir_p(i0_string path) {
+    for (char* p = path + 1;; p++) {
+        if (*p == '/' || *p == '\0') {
+            const char c = *p;
+            *p = '\0';
+            const int failed = mkdir(path, 0755) != 0 && errno != EEXIST;
+            *p = c;
+            if (failed) return -1;
+            if (c == '\0') return 0;
+        }
+    }
+}
+
 static int unlink_cb(const char* fpath, const struct stat* _1, int _2, struct FTW* _3) {
     (void)_1; (void)_2; (void)_3;
     const int ret = remove(fpath);
@@ -251,10 +621,85 @@ static void open_write_int(const char* path, const int i) {
     fclose(f);
 }
 
+// for the supervisor, which must outlive a full or read-only disk
+static int try_write_int(const char* path, const int i) {
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        i0_log(I0_LOG_WARNING, "%s: %s", path, strerror(errno));
+        return -1;
+    }
+    fprintf(f, "%d\n", i);
+    if (fclose(f) != 0) {
+        i0_log(I0_LOG_WARNING, "%s: %s", path, strerror(errno));
+        return -1;
+    }
+    return 0;
+}
+
+// readers see either the old or the new value, never an empty file
+static int try_write_int_atomic(const char* path, const int i) {
+    i0_string tmp;
+    const int n = snprintf(tmp, sizeof(tmp), "%s.new", path);
+    if (n < 0 || n >= (int)sizeof(tmp) || try_write_int(tmp, i) != 0) return -1;
+    if (rename(tmp, path) != 0) {
+        i0_log(I0_LOG_WARNING, "%s: %s", path, strerror(errno));
+        unlink(tmp);
+        return -1;
+    }
+    return 0;
+}
+
+static void open_write_int_atomic(const char* path, const int i) {
+    i0_string tmp;
+    const int n = snprintf(tmp, sizeof(tmp), "%s.new", path);
+    if (n < 0 || n >= (int)sizeof(tmp)) {
+        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_ERROR_BUFFER_OVERFLOW]);
+    }
+    open_write_int(tmp, i);
+    if (rename(tmp, path) != 0) {
+        i0_perror("rename()");
+    }
+}
+
 static int file_exists(const char* path) {
     return access(path, X_OK) == 0;
 }
 
+// for marker files like `enabled`, which are not executable
+static int path_exists(const char* path) {
+    return access(path, F_OK) == 0;
+}
+
+static long read_long(const char* path, const long def) {
+    FILE* f = fopen(path, "r");
+    if (!f) return def;
+
+    long n;
+    if (fscanf(f, "%ld", &n) != 1) n = def;
+    fclose(f);
+    return n;
+}
+
+// first word of a file, empty if there is none
+static void read_word(const char* path, char* buf, const size_t size) {
+    buf[0] = '\0';
+    FILE* f = fopen(path, "r");
+    if (!f) return;
+
+    if (fgets(buf, (int)size, f)) buf[strcspn(buf, " \t\n")] = '\0';
+    fclose(f);
+}
+
+static pid_t read_pid(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) return 0;
+
+    pid_t pid;
+    if (fscanf(f, "%d", &pid) != 1) pid = 0;
+    fclose(f);
+    return pid;
+}
+
 // =========================================== //
 // work with input                             //
 // =========================================== //
@@ -315,465 +760,3795 @@ static void i0_read_prompt(i0_string buf, char* prompt, const int required) {
 }
 
 // =========================================== //
-// actual i0 functionality                     //
+// event journal                               //
 // =========================================== //
 
-static void i0_task_find(const char* name, i0_string path) {
-    i0_get_tasks_dir(path);
-    i0_string_append(path, strlen(path), name, strlen(name) + 1);
+// every task gets its own append-only file of fixed-size records in the
+// events dir, a full file is rotated to "<task>.1". the wall clock can jump
+// around, so records are ordered by boot and then by the monotonic clock:
+// the records of the running boot are the tail of a file and --since is a
+// binary search over that tail. older boots are only filtered
+
+typedef enum i0_event_type {
+    I0_EVENT_START = 0,
+    I0_EVENT_READY,
+    I0_EVENT_EXIT,
+    I0_EVENT_STOP,
+    I0_EVENT_RESTART,
+    I0_EVENT_HEALTH
+} i0_event_type;
+
+#define I0_MAX_EVENT_TYPE I0_EVENT_HEALTH
+
+static char* const i0_event_type_name[I0_MAX_EVENT_TYPE + 1] = {
+    "start",
+    "ready",
+    "exit",
+    "stop",
+    "restart",
+    "health"
+};
 
-    if (!dir_exists(path)) {
-        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_ERROR_TASK_NOT_FOUND]);
-    }
+#define I0_EVENT_SIGNALED 1 // status is a signal number instead of exit code
+
+#define I0_EVENT_MAGIC 0x3245 // "E2" on little endian
+#define I0_EVENTS_SEGMENT_SIZE (64 * 1024)
+#define I0_EVENTS_OPEN_MAX 8
+
+typedef struct i0_event {
+    uint16_t magic;
+    uint8_t type;
+    uint8_t flags;
+    uint32_t boot; // hash of the kernel's boot id
+    int32_t pid;
+    int32_t status;
+    int64_t mono_ns;
+    int64_t wall_ns;
+} i0_event;
+
+typedef struct i0_event_entry {
+    i0_event ev;
+    const char* task;
+} i0_event_entry;
+
+static int64_t i0_clock_ns(const clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
 }
 
-// this code is ass but there's nothing i can do
-_Noreturn static void i0_task_new() {
-    i0_string task_name;
-    i0_read_prompt(task_name, i0_lang[I0_LANG_NEW_NAME], 1);
+static uint32_t i0_boot_tag() {
+    static uint32_t tag;
+    if (tag) return tag;
 
-    i0_string task_path;
-    i0_get_tasks_dir(task_path);
+    char id[64] = {0};
+    FILE* f = fopen("/proc/sys/kernel/random/boot_id", "r");
+    if (f) {
+        if (!fgets(id, sizeof(id), f)) id[0] = '\0';
+        fclose(f);
+    }
 
-    size_t task_path_size = strlen(task_path);
-    const size_t task_name_size = strlen(task_name);
-    if (task_name_size + task_path_size > sizeof(task_path)) {
-        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_NEW_PATH_TOO_LONG]);
+    // fnv-1a, 0 is left for "not known yet"
+    tag = 2166136261u;
+    for (const char* p = id; *p && *p != '\n'; p++) tag = (tag ^ (uint8_t)*p) * 16777619u;
+    if (!tag) tag = 1;
+    return tag;
+}
+
+static int i0_events_open(i0_string path, const char* task) {
+    i0_get_events_dir(path);
+    const size_t dir_len = strlen(path);
+    i0_string_append(path, dir_len, task, strlen(task) + 1);
+
+    int fd = open(path, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0 && errno == ENOENT) {
+        path[dir_len] = '\0';
+        if (try_mkdir_p(path) != 0) return -1;
+        i0_string_append(path, dir_len, task, strlen(task) + 1);
+        fd = open(path, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
     }
+    return fd;
+}
 
-    i0_string_append(task_path, task_path_size, task_name, task_name_size);
+// journal files stay open, so an event costs an fstat and a write. the
+// supervisor logs for many tasks, hence a few of them
+typedef struct i0_events_file {
+    char* task;
+    int fd;
+} i0_events_file;
+
+static i0_events_file i0_events_files[I0_EVENTS_OPEN_MAX];
+static size_t i0_events_files_next;
+
+static int i0_events_get(i0_string path, const char* task) {
+    for (size_t i = 0; i < I0_EVENTS_OPEN_MAX; i++) {
+        if (i0_events_files[i].task && str_eq(i0_events_files[i].task, task)) {
+            i0_get_events_dir(path);
+            i0_string_append(path, strlen(path), task, strlen(task) + 1);
+            return i0_events_files[i].fd;
+        }
+    }
 
-    int rewrite = 0;
+    const int fd = i0_events_open(path, task);
+    if (fd < 0) return -1;
 
-    if (dir_exists(task_path)) {
-        rewrite = i0_prompt_yesno(i0_no, i0_lang[I0_LANG_NEW_TASK_ALREADY_EXISTS], task_path);
-        if (!rewrite) exit(EXIT_SUCCESS);
+    i0_events_file* slot = &i0_events_files[i0_events_files_next++ % I0_EVENTS_OPEN_MAX];
+    if (slot->task) {
+        free(slot->task);
+        close(slot->fd);
     }
+    slot->task = strdup(task);
+    if (!slot->task) i0_perror("strdup()");
+    slot->fd = fd;
+    return fd;
+}
 
-    i0_string task_command;
-    i0_read_prompt(
-        task_command,
-        i0_lang[I0_LANG_NEW_COMMAND],
-        1
-    );
+static void i0_events_forget(const int fd) {
+    for (size_t i = 0; i < I0_EVENTS_OPEN_MAX; i++) {
+        if (i0_events_files[i].task && i0_events_files[i].fd == fd) {
+            free(i0_events_files[i].task);
+            i0_events_files[i].task = NULL;
+        }
+    }
+    close(fd);
+}
 
-    i0_string description;
-    i0_read_prompt(
-        description,
-        i0_lang[I0_LANG_NEW_DESCRIPTION],
-        0
-    );
+// a full file is renamed under a lock on the events dir, so parallel
+// writers never rotate twice and lose a segment. a writer whose file was
+// rotated by someone else just reopens
+static int i0_events_rotate(i0_string path, const char* task, const int fd) {
+    const size_t len = strlen(path);
+    const size_t dir_len = len - strlen(task);
+    path[dir_len] = '\0';
+    const int dir = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    i0_string_append(path, dir_len, task, strlen(task) + 1);
+    if (dir < 0) return -1;
+
+    while (flock(dir, LOCK_EX) != 0 && errno == EINTR) ;
+
+    struct stat ours, current;
+    if (fstat(fd, &ours) == 0 && stat(path, &current) == 0
+        && ours.st_ino == current.st_ino
+        && current.st_size + (off_t)sizeof(i0_event) > I0_EVENTS_SEGMENT_SIZE) {
+        i0_string old;
+        memcpy(old, path, len);
+        i0_string_append(old, len, ".1", conststrlen(".1") + 1);
+        rename(path, old);
+    }
+    close(dir);
 
-    const i0_yesno autostart = i0_prompt_yesno(i0_no, "%s", i0_lang[I0_LANG_NEW_AUTOSTART]);
+    i0_events_forget(fd);
+    return i0_events_get(path, task);
+}
 
-    const i0_yesno make_start = i0_prompt_yesno(i0_no, "%s", i0_lang[I0_LANG_NEW_START]);
-    const i0_yesno make_stop = i0_prompt_yesno(i0_no, "%s", i0_lang[I0_LANG_NEW_STOP]);
-    const i0_yesno make_status = i0_prompt_yesno(i0_no, "%s", i0_lang[I0_LANG_NEW_STATUS]);
+static void i0_event_log(const char* task, const i0_event_type type, const pid_t pid, const int status, const int flags) {
+    const i0_event ev = {
+        .magic = I0_EVENT_MAGIC,
+        .type = type,
+        .flags = flags,
+        .boot = i0_boot_tag(),
+        .pid = pid,
+        .status = status,
+        .mono_ns = i0_clock_ns(CLOCK_MONOTONIC),
+        .wall_ns = i0_clock_ns(CLOCK_REALTIME)
+    };
 
-    if (rewrite) rmdir_rf(task_path);
-    mkdir_p(task_path);
-    task_path_size = strlen(task_path);
+    i0_string path;
+    int fd = i0_events_get(path, task);
+    if (fd < 0) goto fail;
 
-    {
-        i0_string_append(task_path, task_path_size, "/main", conststrlen("/main") + 1);
-        i0_string main_script;
-        snprintf(
-            main_script,
-            sizeof(main_script),
-            I0_MAIN_SCRIPT,
-            task_command
-        );
-        open_write(task_path, main_script, strlen(main_script));
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size + (off_t)sizeof(ev) > I0_EVENTS_SEGMENT_SIZE) {
+        fd = i0_events_rotate(path, task, fd);
+        if (fd < 0) goto fail;
     }
 
-    if (make_start) {
-        char _already_buf[256];
-        snprintf(
-            _already_buf, sizeof(_already_buf),
-            i0_lang[I0_LANG_STATUS_ALREADY_RUNNING],
-            "$pid"
-        );
-
-        char already_buf[256];
-        snprintf(
-            already_buf, sizeof(already_buf),
-            "%s[%c] %s\033[0m",
-            i0_log_type_color[I0_LOG_WARNING],
-            i0_log_type_char[I0_LOG_WARNING],
-            _already_buf
-        );
+    if (write(fd, &ev, sizeof(ev)) != (ssize_t)sizeof(ev)) {
+        i0_events_forget(fd);
+        goto fail;
+    }
+    return;
+fail:
+    // losing history is bad but not worth failing a start or stop over
+    i0_log(I0_LOG_WARNING, i0_lang[I0_LANG_ERROR_EVENTS_WRITE], strerror(errno));
+}
 
-        char _started_buf[256];
-        snprintf(_started_buf, sizeof(_started_buf),
-            i0_lang[I0_LANG_STATUS_STARTED],
-            task_name
-        );
+static int i0_event_read_at(const int fd, const size_t i, i0_event* ev) {
+    return pread(fd, ev, sizeof(*ev), (off_t)(i * sizeof(*ev))) == (ssize_t)sizeof(*ev);
+}
 
-        char started_buf[256];
-        snprintf(
-            started_buf, sizeof(started_buf),
-            "%s[%c] %s\033[0m",
-            i0_log_type_color[I0_LOG_TASK_START],
-            i0_log_type_char[I0_LOG_TASK_START],
-            _started_buf
-        );
+#define I0_EVENT_BIT(type) (1u << (type))
 
-        i0_string_append(task_path, task_path_size, "/start", conststrlen("/start") + 1);
-        i0_string start_script;
-        snprintf(
-            start_script,
-            sizeof(start_script),
-            I0_START_SCRIPT,
-            already_buf,
-            started_buf
-        );
-        open_write(task_path, start_script, strlen(start_script));
+// the newest event for task of any type in the I0_EVENT_BIT() mask, of a
+// given pid unless pid is 0
+static int i0_event_find_any(const char* task, const unsigned types, const pid_t pid, i0_event* out) {
+    i0_string path;
+    i0_get_events_dir(path);
+    const size_t len = strlen(path) + strlen(task);
+    i0_string_append(path, strlen(path), task, strlen(task) + 1);
+
+    for (int segment = 0; segment < 2; segment++) {
+        if (segment == 1) i0_string_append(path, len, ".1", conststrlen(".1") + 1);
+
+        const int fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) continue;
+
+        struct stat st;
+        size_t i = fstat(fd, &st) == 0 ? (size_t)st.st_size / sizeof(i0_event) : 0;
+        while (i-- > 0) {
+            i0_event ev;
+            if (!i0_event_read_at(fd, i, &ev) || ev.magic != I0_EVENT_MAGIC) continue;
+            if (ev.type > I0_MAX_EVENT_TYPE || !(types & I0_EVENT_BIT(ev.type)) || (pid && ev.pid != pid)) continue;
+
+            *out = ev;
+            close(fd);
+            return 0;
+        }
+        close(fd);
     }
+    return -1;
+}
 
-    if (make_status) {
-        char enabled_buf[256];
-        snprintf(
-            enabled_buf, sizeof(enabled_buf),
-            "%s[%c] %s\033[0m",
-            i0_log_type_color[I0_LOG_GOOD],
-            i0_log_type_char[I0_LOG_GOOD],
-            i0_lang[I0_LANG_STATUS_ENABLED]
-        );
+static int i0_event_find(const char* task, const i0_event_type type, const pid_t pid, i0_event* out) {
+    return i0_event_find_any(task, I0_EVENT_BIT(type), pid, out);
+}
 
-        char description_buf[256];
-        snprintf(
-            description_buf, sizeof(description_buf),
-            "%s[%c] %s: %%s\033[0m",
-            i0_log_type_color[I0_LOG_INFO],
-            i0_log_type_char[I0_LOG_INFO],
-            i0_lang[I0_LANG_STATUS_DESCRIPTION]
-        );
+// shell style, 128 + N for signal N
+static int i0_event_exit_status(const i0_event* ev) {
+    return ev->flags & I0_EVENT_SIGNALED ? 128 + ev->status : ev->status;
+}
 
-        char not_running_buf[256];
-        snprintf(
-            not_running_buf, sizeof(not_running_buf),
-            "%s[%c] %s\033[0m",
-            i0_log_type_color[I0_LOG_BAD],
-            i0_log_type_char[I0_LOG_BAD],
-            i0_lang[I0_LANG_STATUS_NOT_RUNNING]
-        );
+// appends every record from path that happened at or after since
+static void i0_events_load(const char* path, const char* task, const int64_t since,
+                           i0_event_entry** entries, size_t* count, size_t* cap) {
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return;
 
-        char _running_buf[256];
-        snprintf(
-            _running_buf, sizeof(_running_buf),
-            i0_lang[I0_LANG_STATUS_RUNNING],
-            "$pid"
-        );
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return;
+    }
 
-        char running_buf[256];
-        snprintf(
-            running_buf, sizeof(running_buf),
-            "%s[%c] %s\033[0m",
-            i0_log_type_color[I0_LOG_GOOD],
-            i0_log_type_char[I0_LOG_GOOD],
-            _running_buf
-        );
+    const uint32_t boot = i0_boot_tag();
+    const size_t n = (size_t)st.st_size / sizeof(i0_event);
+
+    // where the records of this boot begin
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        i0_event ev;
+        if (!i0_event_read_at(fd, mid, &ev)) break;
+        if (ev.boot != boot) lo = mid + 1;
+        else hi = mid;
+    }
+    const size_t this_boot = lo;
 
-        char _started_at_buf[256];
-        snprintf(
-            _started_at_buf, sizeof(_started_at_buf),
-            i0_lang[I0_LANG_STATUS_STARTED_AT],
-            "$(date -r pid '+%Y-%m-%d %H:%M:%S')"
-        );
+    // then the lower bound on the monotonic clock within them
+    int64_t since_mono = INT64_MIN;
+    if (since != INT64_MIN) {
+        since_mono = since - (i0_clock_ns(CLOCK_REALTIME) - i0_clock_ns(CLOCK_MONOTONIC));
+    }
+    hi = n;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        i0_event ev;
+        if (!i0_event_read_at(fd, mid, &ev)) break;
+        if (ev.mono_ns < since_mono) lo = mid + 1;
+        else hi = mid;
+    }
 
-        char started_at_buf[256];
-        snprintf(
-            started_at_buf, sizeof(started_at_buf),
-            "%s[%c] %s\033[0m",
-            i0_log_type_color[I0_LOG_GOOD],
-            i0_log_type_char[I0_LOG_GOOD],
-            _started_at_buf
-        );
+    for (size_t i = 0; i < n; i++) {
+        if (i == this_boot) i = lo;
+        if (i == n) break;
 
-        i0_string_append(task_path, task_path_size, "/status", conststrlen("/status") + 1);
-        i0_string status_script;
-        snprintf(
-            status_script,
-            sizeof(status_script),
-            I0_STATUS_SCRIPT,
-            enabled_buf,
-            description_buf,
-            not_running_buf,
-            not_running_buf,
-            running_buf,
-            started_at_buf
-        );
-        open_write(task_path, status_script, strlen(status_script));
+        i0_event ev;
+        if (!i0_event_read_at(fd, i, &ev)) break;
+        if (ev.magic != I0_EVENT_MAGIC || ev.type > I0_MAX_EVENT_TYPE) continue;
+        if (i < this_boot && ev.wall_ns < since) continue;
+
+        if (*count == *cap) {
+            *cap = *cap ? *cap * 2 : 64;
+            *entries = realloc(*entries, *cap * sizeof(**entries));
+            if (!*entries) i0_perror("realloc()");
+        }
+        (*entries)[(*count)++] = (i0_event_entry){ .ev = ev, .task = task };
     }
+    close(fd);
+}
 
-    if (make_stop) {
-        char already_buf[256];
-        snprintf(
-            already_buf, sizeof(already_buf),
-            "%s[%c] %s\033[0m",
-            i0_log_type_color[I0_LOG_WARNING],
-            i0_log_type_char[I0_LOG_WARNING],
-            i0_lang[I0_LANG_STATUS_ALREADY_STOPPED]
-        );
+// this boot after every earlier one, earlier boots by the wall clock as
+// that is all they have in common
+static int i0_event_entry_cmp(const void* a, const void* b) {
+    const i0_event* x = &((const i0_event_entry*)a)->ev;
+    const i0_event* y = &((const i0_event_entry*)b)->ev;
+    const uint32_t boot = i0_boot_tag();
 
-        char _stopped_buf[256];
-        snprintf(_stopped_buf, sizeof(_stopped_buf),
-            i0_lang[I0_LANG_STATUS_STOPPED],
-            task_name
-        );
+    if ((x->boot == boot) != (y->boot == boot)) return x->boot == boot ? 1 : -1;
+    if (x->boot != y->boot) return (x->wall_ns > y->wall_ns) - (x->wall_ns < y->wall_ns);
+    return (x->mono_ns > y->mono_ns) - (x->mono_ns < y->mono_ns);
+}
 
-        char stopped_buf[256];
-        snprintf(
-            stopped_buf, sizeof(stopped_buf),
-            "%s[%c] %s\033[0m",
-            i0_log_type_color[I0_LOG_TASK_STOP],
-            i0_log_type_char[I0_LOG_TASK_STOP],
-            _stopped_buf
-        );
+// accepts unix seconds, "<N>s/m/h/d" ago, "YYYY-MM-DD" or "YYYY-MM-DD HH:MM:SS"
+static int64_t i0_parse_since(const char* s) {
+    char* end;
+    const long long n = strtoll(s, &end, 10);
+    if (end != s && n >= 0) {
+        long long unit = 0;
+        if (*end == '\0') return n * 1000000000;
+        if (str_eq(end, "s")) unit = 1;
+        if (str_eq(end, "m")) unit = 60;
+        if (str_eq(end, "h")) unit = 60 * 60;
+        if (str_eq(end, "d")) unit = 24 * 60 * 60;
+        if (unit) return i0_clock_ns(CLOCK_REALTIME) - n * unit * 1000000000;
+    }
+
+    struct tm tm = {0};
+    end = strptime(s, "%Y-%m-%d", &tm);
+    if (end && *end == ' ') end = strptime(end + 1, "%H:%M:%S", &tm);
+    if (!end || *end != '\0') {
+        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_ERROR_EVENTS_BAD_SINCE]);
+    }
+    tm.tm_isdst = -1;
+    return (int64_t)mktime(&tm) * 1000000000;
+}
+
+static void i0_event_print(const i0_event_entry* e) {
+    const time_t sec = (time_t)(e->ev.wall_ns / 1000000000);
+    char time_buf[64];
+    struct tm* tm = localtime(&sec);
+    if (!tm || !strftime(time_buf, sizeof(time_buf), "%Y-%m-%d %H:%M:%S", tm)) {
+        snprintf(time_buf, sizeof(time_buf), "%lld", (long long)sec);
+    }
+
+    printf(
+        "%s.%03d %s %s pid=%d %s=%d\n",
+        time_buf,
+        (int)(e->ev.wall_ns / 1000000 % 1000),
+        e->task,
+        i0_event_type_name[e->ev.type],
+        e->ev.pid,
+        e->ev.flags & I0_EVENT_SIGNALED ? "signal" : "status",
+        e->ev.status
+    );
+}
+
+static void i0_events(const int argc, const char* argv[]) {
+    const char* task = NULL;
+    int64_t since = INT64_MIN;
+
+    for (int i = 0; i < argc; i++) {
+        if (str_eq(argv[i], "--since")) {
+            if (++i == argc) i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_ERROR_EVENTS_BAD_SINCE]);
+            since = i0_parse_since(argv[i]);
+        }
+        else if (!task && argv[i][0] != '-') {
+            task = argv[i];
+        }
+        else {
+            i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_ERROR_UNKNOWN_COMMAND]);
+        }
+    }
+
+    i0_string path;
+    i0_get_events_dir(path);
+    const size_t dir_len = strlen(path);
+
+    i0_event_entry* entries = NULL;
+    size_t count = 0, cap = 0;
+    char** names = NULL;
+    size_t name_count = 0, name_cap = 0;
+
+    if (task) {
+        i0_string_append(path, dir_len, task, strlen(task));
+        const size_t len = dir_len + strlen(task);
+        i0_string_append(path, len, ".1", conststrlen(".1") + 1);
+        i0_events_load(path, task, since, &entries, &count, &cap);
+        path[len] = '\0';
+        i0_events_load(path, task, since, &entries, &count, &cap);
+    }
+    else {
+        DIR* d = opendir(path);
+        if (!d) {
+            if (errno == ENOENT) return;
+            i0_perror("opendir()");
+        }
+
+        struct dirent* dir;
+        while ((dir = readdir(d)) != NULL) {
+            if (dir->d_name[0] == '.') continue;
+
+            char* name = strdup(dir->d_name);
+            if (!name) i0_perror("strdup()");
+
+            if (name_count == name_cap) {
+                name_cap = name_cap ? name_cap * 2 : 64;
+                names = realloc(names, name_cap * sizeof(*names));
+                if (!names) i0_perror("realloc()");
+            }
+            names[name_count++] = name;
+
+            const size_t name_len = strlen(name);
+            i0_string_append(path, dir_len, name, name_len + 1);
+
+            // "<task>.1" is the previous segment of "<task>"
+            if (name_len > 2 && str_eq(name + name_len - 2, ".1")) name[name_len - 2] = '\0';
+            i0_events_load(path, name, since, &entries, &count, &cap);
+        }
+        closedir(d);
+    }
+
+    qsort(entries, count, sizeof(*entries), i0_event_entry_cmp);
+    for (size_t i = 0; i < count; i++) {
+        i0_event_print(&entries[i]);
+    }
+    free(entries);
+    for (size_t i = 0; i < name_count; i++) free(names[i]);
+    free(names);
+}
+
+// =========================================== //
+// fd store                                    //
+// =========================================== //
+
+// tasks can leave file descriptors (listening sockets, memfds, ...) with the
+// supervisor over its socket. every later start of the task gets them back
+// from fd 3 on, described by $I0_FDS and the colon separated $I0_FDNAMES.
+//
+// requests are single seqpacket messages:
+//   "store <name>" + one fd   keep fd for the sender's task under name
+//   "remove <name>"           forget it
+//   "fetch <task>"            reply "<name>:<name>..." + all fds of task
+
+#define I0_FDSTORE_MAX 64
+#define I0_FDSTORE_SOCKET "fdstore.sock"
+#define I0_SUPERVISOR_PID "supervise.pid"
+
+// clients of the control socket get this long (ms) to send their request
+#define I0_CTL_TIMEOUT 1000
+#define I0_CTL_CLIENTS 16
+// and callers wait this long (s) for a reply, a reexec answers from the new binary
+#define I0_CTL_REPLY_TIMEOUT 30
+
+typedef union i0_cmsg_buf {
+    char buf[CMSG_SPACE(sizeof(int) * I0_FDSTORE_MAX)];
+    struct cmsghdr align;
+} i0_cmsg_buf;
+
+static int i0_fdstore_addr(struct sockaddr_un* addr) {
+    i0_string path;
+    i0_get_runtime_dir(path);
+    i0_string_append(path, strlen(path), I0_FDSTORE_SOCKET, conststrlen(I0_FDSTORE_SOCKET) + 1);
+
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr->sun_path)) return -1;
+    strcpy(addr->sun_path, path);
+    return 0;
+}
+
+static ssize_t i0_send_fds(const int sock, const char* msg, const int* fds, const size_t n) {
+    struct iovec iov = { .iov_base = (void*)msg, .iov_len = strlen(msg) + 1 };
+    i0_cmsg_buf cmsg;
+    struct msghdr mh = { .msg_iov = &iov, .msg_iovlen = 1 };
+
+    if (n > 0) {
+        mh.msg_control = cmsg.buf;
+        mh.msg_controllen = CMSG_SPACE(sizeof(int) * n);
+        struct cmsghdr* c = CMSG_FIRSTHDR(&mh);
+        c->cmsg_level = SOL_SOCKET;
+        c->cmsg_type = SCM_RIGHTS;
+        c->cmsg_len = CMSG_LEN(sizeof(int) * n);
+        memcpy(CMSG_DATA(c), fds, sizeof(int) * n);
+    }
+    return sendmsg(sock, &mh, MSG_NOSIGNAL);
+}
+
+// receives a message into a nul terminated buf, fds come in close-on-exec
+static ssize_t i0_recv_fds(const int sock, char* buf, const size_t size, int* fds, size_t* n) {
+    struct iovec iov = { .iov_base = buf, .iov_len = size - 1 };
+    i0_cmsg_buf cmsg;
+    struct msghdr mh = {
+        .msg_iov = &iov,
+        .msg_iovlen = 1,
+        .msg_control = cmsg.buf,
+        .msg_controllen = sizeof(cmsg.buf)
+    };
+
+    *n = 0;
+    const ssize_t len = recvmsg(sock, &mh, MSG_CMSG_CLOEXEC);
+    if (len < 0) return len;
+    buf[len] = '\0';
+
+    for (struct cmsghdr* c = CMSG_FIRSTHDR(&mh); c; c = CMSG_NXTHDR(&mh, c)) {
+        if (c->cmsg_level != SOL_SOCKET || c->cmsg_type != SCM_RIGHTS) continue;
+        const size_t count = (c->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (size_t i = 0; i < count && *n < I0_FDSTORE_MAX; i++) {
+            memcpy(&fds[(*n)++], CMSG_DATA(c) + i * sizeof(int), sizeof(int));
+        }
+    }
+    return len;
+}
+
+static int i0_fdstore_connect() {
+    struct sockaddr_un addr;
+    if (i0_fdstore_addr(&addr) != 0) return -1;
+
+    const int sock = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (sock < 0) return -1;
+
+    // a supervisor that never answers must not hang us
+    const struct timeval timeout = { .tv_sec = I0_CTL_REPLY_TIMEOUT };
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    if (connect(sock, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+// one request and its reply, -1 if there is no supervisor to talk to
+static int i0_fdstore_call(const char* req, const int* fds, const size_t n,
+                           char* reply, const size_t size, int* rfds, size_t* rn) {
+    const int sock = i0_fdstore_connect();
+    if (sock < 0) return -1;
+
+    int ret = -1;
+    if (i0_send_fds(sock, req, fds, n) >= 0 && i0_recv_fds(sock, reply, size, rfds, rn) > 0) ret = 0;
+    close(sock);
+    return ret;
+}
+
+// runs in the child that is about to exec into the task
+static void i0_fdstore_inherit(const char* task) {
+    struct sockaddr_un addr;
+    if (i0_fdstore_addr(&addr) == 0) setenv("I0_FDSTORE", addr.sun_path, 1);
+
+    char req[300];
+    char names[I0_FDSTORE_MAX * 65 + 1];
+    int fds[I0_FDSTORE_MAX];
+    size_t n = 0;
+    snprintf(req, sizeof(req), "fetch %s", task);
+    if (i0_fdstore_call(req, NULL, 0, names, sizeof(names), fds, &n) != 0 || n == 0) return;
+
+    // get out of the way of 3..3+n before putting them there
+    for (size_t i = 0; i < n; i++) {
+        const int fd = fcntl(fds[i], F_DUPFD_CLOEXEC, (int)(3 + n));
+        close(fds[i]);
+        fds[i] = fd;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (fds[i] < 0 || dup2(fds[i], (int)(3 + i)) < 0) {
+            i0_perror("dup2()");
+        }
+        close(fds[i]);
+    }
+
+    char count[16];
+    snprintf(count, sizeof(count), "%zu", n);
+    setenv("I0_FDS", count, 1);
+    setenv("I0_FDNAMES", names, 1);
+}
+
+static int i0_fdstore_name_ok(const char* name) {
+    const size_t len = strlen(name);
+    return len > 0 && len <= 64 && !strpbrk(name, ":\t\n");
+}
+
+// i0 fdstore <name> <fd> | i0 fdstore --remove <name>
+static int i0_fdstore(const int argc, const char* argv[]) {
+    char req[300];
+    int fd = -1;
+
+    if (argc == 2 && str_eq(argv[0], "--remove") && i0_fdstore_name_ok(argv[1])) {
+        snprintf(req, sizeof(req), "remove %s", argv[1]);
+    }
+    else if (argc == 2 && i0_fdstore_name_ok(argv[0])) {
+        char* end;
+        fd = (int)strtol(argv[1], &end, 10);
+        if (*end != '\0' || fd < 0 || fcntl(fd, F_GETFD) < 0) {
+            i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_FDSTORE_USAGE]);
+        }
+        snprintf(req, sizeof(req), "store %s", argv[0]);
+    }
+    else {
+        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_FDSTORE_USAGE]);
+    }
+
+    char reply[16];
+    int rfds[I0_FDSTORE_MAX];
+    size_t rn;
+    if (i0_fdstore_call(req, fd >= 0 ? &fd : NULL, fd >= 0, reply, sizeof(reply), rfds, &rn) != 0) {
+        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_FDSTORE_NO_SUPERVISOR]);
+    }
+    if (!str_eq(reply, "ok")) {
+        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_FDSTORE_REFUSED]);
+    }
+    return EXIT_SUCCESS;
+}
+
+// =========================================== //
+// actual i0 functionality                     //
+// =========================================== //
+
+typedef void (*i0_task_action)(const char* task, const char* path);
+
+static void i0_task_find(const char* name, i0_string path) {
+    i0_get_tasks_dir(path);
+    i0_string_append(path, strlen(path), name, strlen(name) + 1);
+
+    if (!dir_exists(path)) {
+        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_ERROR_TASK_NOT_FOUND]);
+    }
+}
+
+// everything a task dir is made of, whether it came from the prompts, from
+// `i0 new` flags or from a manifest
+
+typedef struct i0_task_file {
+    char* name;
+    char* content;
+} i0_task_file;
+
+typedef struct i0_task_spec {
+    char* name;
+    char* command;
+    char* description;
+    int enabled;
+    int start;
+    int stop;
+    int status;
+    i0_task_file* files; // anything else, e.g. group or ready.timeout
+    size_t file_count;
+} i0_task_spec;
+
+// a task or file name that stays inside its dir and is not hidden
+static int i0_name_ok(const char* name) {
+    return name[0] != '\0' && name[0] != '.' && !strchr(name, '/');
+}
+
+// the reexec state separates fields by tabs and records by newlines, names
+// with either cannot be written down there and are left behind
+static int i0_state_ok(const char* s) {
+    return !strpbrk(s, "\t\n");
+}
+
+// files i0 runs, they need the exec bit whatever wrote them
+static int i0_task_file_is_script(const char* name) {
+    return str_eq(name, "start") || str_eq(name, "stop") || str_eq(name, "status")
+        || str_eq(name, "healthcheck");
+}
+
+static void i0_task_write(const i0_task_spec* spec, i0_string path) {
+    const size_t len = strlen(path);
+
+    {
+        i0_string_append(path, len, "/main", conststrlen("/main") + 1);
+        i0_string main_script;
+        snprintf(
+            main_script,
+            sizeof(main_script),
+            I0_MAIN_SCRIPT,
+            spec->command
+        );
+        open_write(path, main_script, strlen(main_script));
+    }
+
+    if (spec->start) {
+        char already_buf[256];
+        snprintf(already_buf, sizeof(already_buf), i0_lang[I0_LANG_STATUS_ALREADY_RUNNING], "$pid");
+
+        char started_buf[256];
+        snprintf(started_buf, sizeof(started_buf), i0_lang[I0_LANG_STATUS_STARTED], spec->name);
+
+        i0_string_append(path, len, "/start", conststrlen("/start") + 1);
+        i0_string start_script;
+        snprintf(
+            start_script,
+            sizeof(start_script),
+            I0_START_SCRIPT,
+            already_buf,
+            started_buf
+        );
+        open_write(path, start_script, strlen(start_script));
+    }
+
+    if (spec->status) {
+        char running_buf[256];
+        snprintf(running_buf, sizeof(running_buf), i0_lang[I0_LANG_STATUS_RUNNING], "$pid");
+
+        char started_at_buf[256];
+        snprintf(
+            started_at_buf, sizeof(started_at_buf),
+            i0_lang[I0_LANG_STATUS_STARTED_AT],
+            "$(date -r \"$pidfile\" '+%Y-%m-%d %H:%M:%S')"
+        );
+
+        i0_string_append(path, len, "/status", conststrlen("/status") + 1);
+        i0_string status_script;
+        snprintf(
+            status_script,
+            sizeof(status_script),
+            I0_STATUS_SCRIPT,
+            i0_lang[I0_LANG_STATUS_ENABLED],
+            i0_lang[I0_LANG_STATUS_DESCRIPTION],
+            i0_lang[I0_LANG_STATUS_NOT_RUNNING],
+            i0_lang[I0_LANG_STATUS_NOT_RUNNING],
+            running_buf,
+            started_at_buf
+        );
+        open_write(path, status_script, strlen(status_script));
+    }
+
+    if (spec->stop) {
+        char stopped_buf[256];
+        snprintf(stopped_buf, sizeof(stopped_buf), i0_lang[I0_LANG_STATUS_STOPPED], spec->name);
 
-        i0_string_append(task_path, task_path_size, "/stop", conststrlen("/stop") + 1);
+        i0_string_append(path, len, "/stop", conststrlen("/stop") + 1);
         i0_string stop_script;
         snprintf(
             stop_script,
             sizeof(stop_script),
             I0_STOP_SCRIPT,
-            already_buf,
-            already_buf,
+            i0_lang[I0_LANG_STATUS_ALREADY_STOPPED],
+            i0_lang[I0_LANG_STATUS_ALREADY_STOPPED],
             stopped_buf
         );
-        open_write(task_path, stop_script, strlen(stop_script));
+        open_write(path, stop_script, strlen(stop_script));
+    }
+
+    if (spec->description && spec->description[0] != '\0') {
+        i0_string description;
+        // posix standard thing idk
+        const int n = snprintf(description, sizeof(description), "%s\n", spec->description);
+        i0_string_append(path, len, "/description", conststrlen("/description") + 1);
+        open_write(path, description, (size_t)n < sizeof(description) ? (size_t)n : sizeof(description) - 1);
+    }
+
+    if (spec->enabled) {
+        i0_string_append(path, len, "/enabled", conststrlen("/enabled") + 1);
+        FILE* f = safe_fopen(path, "w");
+        fclose(f);
+    }
+
+    for (size_t i = 0; i < spec->file_count; i++) {
+        const i0_task_file* file = &spec->files[i];
+        const size_t name_len = strlen(file->name);
+        i0_string_append(path, len, "/", 1);
+        i0_string_append(path, len + 1, file->name, name_len + 1);
+
+        FILE* f = safe_fopen(path, "w");
+        fprintf(f, "%s\n", file->content);
+        fclose(f);
+        if (i0_task_file_is_script(file->name)) chmod(path, rwxr_xr_x);
+    }
+
+    path[len] = '\0';
+}
+
+// the task is written into a hidden staging dir next to the others and
+// renamed into place, so nobody ever sees half of it. returns -1 if it
+// already exists and must not be replaced
+static int i0_task_install(const i0_task_spec* spec, const int replace, i0_string path) {
+    i0_get_tasks_dir(path);
+    mkdir_p(path);
+
+    i0_string staging;
+    snprintf(staging, sizeof(staging), "%s.new-XXXXXX", path);
+    if (!mkdtemp(staging)) {
+        i0_perror("mkdtemp()");
+    }
+    chmod(staging, rwxr_xr_x);
+
+    const size_t path_len = strlen(path);
+    const size_t name_len = strlen(spec->name);
+    if (path_len + name_len >= sizeof(i0_string)) {
+        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_NEW_PATH_TOO_LONG]);
+    }
+    i0_string_append(path, path_len, spec->name, name_len + 1);
+
+    i0_task_write(spec, staging);
+
+    if (!dir_exists(path)) {
+        if (rename(staging, path) != 0) i0_perror("rename()");
+        return 0;
+    }
+
+    if (!replace) {
+        rmdir_rf(staging);
+        return -1;
+    }
+
+    // the old dir ends up in staging and goes away with it
+    if (renameat2(AT_FDCWD, staging, AT_FDCWD, path, RENAME_EXCHANGE) != 0) {
+        rmdir_rf(path);
+        if (rename(staging, path) != 0) i0_perror("rename()");
+        return 0;
+    }
+    rmdir_rf(staging);
+    return 0;
+}
+
+// there is no task index to update, the supervisor only has to reread the
+// watch files, once for the whole batch. asked over its socket rather than
+// with a signal, a stale pid file must not get some other process killed
+static void i0_supervisor_reload() {
+    char reply[16];
+    int fds[I0_FDSTORE_MAX];
+    size_t n = 0;
+    if (i0_fdstore_call("reload", NULL, 0, reply, sizeof(reply), fds, &n) != 0) return;
+    for (size_t i = 0; i < n; i++) close(fds[i]);
+}
+
+// this code is ass but there's nothing i can do
+_Noreturn static void i0_task_new_interactive() {
+    i0_task_spec spec = {0};
+    i0_string task_name;
+    i0_read_prompt(task_name, i0_lang[I0_LANG_NEW_NAME], 1);
+    spec.name = task_name;
+    if (!i0_name_ok(task_name)) {
+        i0_log(I0_LOG_CRITICAL, i0_lang[I0_LANG_NEW_BAD_NAME], task_name);
+    }
+
+    i0_string task_path;
+    i0_get_tasks_dir(task_path);
+
+    const size_t task_path_size = strlen(task_path);
+    const size_t task_name_size = strlen(task_name);
+    if (task_name_size + task_path_size > sizeof(task_path)) {
+        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_NEW_PATH_TOO_LONG]);
+    }
+
+    i0_string_append(task_path, task_path_size, task_name, task_name_size);
+
+    if (dir_exists(task_path)) {
+        const int rewrite = i0_prompt_yesno(i0_no, i0_lang[I0_LANG_NEW_TASK_ALREADY_EXISTS], task_path);
+        if (!rewrite) exit(EXIT_SUCCESS);
+    }
+
+    i0_string task_command;
+    i0_read_prompt(
+        task_command,
+        i0_lang[I0_LANG_NEW_COMMAND],
+        1
+    );
+    spec.command = task_command;
+
+    i0_string description;
+    i0_read_prompt(
+        description,
+        i0_lang[I0_LANG_NEW_DESCRIPTION],
+        0
+    );
+    spec.description = description;
+
+    spec.enabled = i0_prompt_yesno(i0_no, "%s", i0_lang[I0_LANG_NEW_AUTOSTART]);
+
+    spec.start = i0_prompt_yesno(i0_no, "%s", i0_lang[I0_LANG_NEW_START]);
+    spec.stop = i0_prompt_yesno(i0_no, "%s", i0_lang[I0_LANG_NEW_STOP]);
+    spec.status = i0_prompt_yesno(i0_no, "%s", i0_lang[I0_LANG_NEW_STATUS]);
+
+    i0_task_install(&spec, 1, task_path);
+    i0_supervisor_reload();
+    i0_log(I0_LOG_GOOD, i0_lang[I0_LANG_NEW_TASK_CREATED], task_path);
+    exit(EXIT_SUCCESS);
+}
+
+// i0 new [--name <task> --command <cmd> [--description <text>] [--enabled]
+//        [--start] [--stop] [--status] [--force]]
+_Noreturn static void i0_task_new(const int argc, const char* argv[]) {
+    if (argc == 0) i0_task_new_interactive();
+
+    i0_task_spec spec = {0};
+    int force = 0;
+
+    for (int i = 0; i < argc; i++) {
+        const int has_value = i + 1 < argc;
+        if (str_eq(argv[i], "--name") && has_value) spec.name = (char*)argv[++i];
+        else if (str_eq(argv[i], "--command") && has_value) spec.command = (char*)argv[++i];
+        else if (str_eq(argv[i], "--description") && has_value) spec.description = (char*)argv[++i];
+        else if (str_eq(argv[i], "--enabled")) spec.enabled = 1;
+        else if (str_eq(argv[i], "--start")) spec.start = 1;
+        else if (str_eq(argv[i], "--stop")) spec.stop = 1;
+        else if (str_eq(argv[i], "--status")) spec.status = 1;
+        else if (str_eq(argv[i], "--force")) force = 1;
+        else i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_NEW_USAGE]);
+    }
+
+    if (!spec.name || !spec.command || !spec.command[0]) {
+        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_NEW_USAGE]);
+    }
+    if (!i0_name_ok(spec.name)) {
+        i0_log(I0_LOG_CRITICAL, i0_lang[I0_LANG_NEW_BAD_NAME], spec.name);
+    }
+
+    i0_string path;
+    if (i0_task_install(&spec, force, path) != 0) {
+        i0_log(I0_LOG_CRITICAL, i0_lang[I0_LANG_NEW_TASK_EXISTS], path);
+    }
+    i0_supervisor_reload();
+    i0_log(I0_LOG_GOOD, i0_lang[I0_LANG_NEW_TASK_CREATED], path);
+    exit(EXIT_SUCCESS);
+}
+
+// i0 import <manifest>, or - for stdin. every task in it is created or
+// replaced, so importing the same manifest again changes nothing
+//
+//   [web]
+//   command = /usr/bin/web --port 80
+//   description = the web frontend
+//   enabled = yes
+//   scripts = start,stop,status
+//   group = web                      any other key is written as a file
+
+static char* i0_trim(char* s) {
+    while (*s == ' ' || *s == '\t') s++;
+    size_t len = strlen(s);
+    while (len > 0 && strchr(" \t\r\n", s[len - 1])) s[--len] = '\0';
+    return s;
+}
+
+static int i0_import_bool(const char* value) {
+    return str_eq(value, "yes") || str_eq(value, "true") || str_eq(value, "on") || str_eq(value, "1");
+}
+
+static void i0_import_line(i0_task_spec* spec, const char* manifest, const size_t line_no, char* key, char* value) {
+    if (str_eq(key, "command")) {
+        free(spec->command);
+        spec->command = strdup(value);
+        if (!spec->command) i0_perror("strdup()");
+    }
+    else if (str_eq(key, "description")) {
+        free(spec->description);
+        spec->description = strdup(value);
+        if (!spec->description) i0_perror("strdup()");
+    }
+    else if (str_eq(key, "enabled")) {
+        spec->enabled = i0_import_bool(value);
+    }
+    else if (str_eq(key, "scripts")) {
+        spec->start = spec->stop = spec->status = 0;
+        for (char* script = strtok(value, ", "); script; script = strtok(NULL, ", ")) {
+            if (str_eq(script, "start")) spec->start = 1;
+            else if (str_eq(script, "stop")) spec->stop = 1;
+            else if (str_eq(script, "status")) spec->status = 1;
+            else i0_log(I0_LOG_CRITICAL, i0_lang[I0_LANG_IMPORT_BAD_SCRIPT], manifest, line_no, script);
+        }
+    }
+    else if (i0_name_ok(key) && !str_eq(key, "main")) {
+        spec->files = realloc(spec->files, (spec->file_count + 1) * sizeof(*spec->files));
+        if (!spec->files) i0_perror("realloc()");
+        i0_task_file* file = &spec->files[spec->file_count++];
+        file->name = strdup(key);
+        file->content = strdup(value);
+        if (!file->name || !file->content) i0_perror("strdup()");
+    }
+    else {
+        i0_log(I0_LOG_CRITICAL, i0_lang[I0_LANG_NEW_BAD_NAME], key);
+    }
+}
+
+static int i0_import(const int argc, const char* argv[]) {
+    if (argc != 1) {
+        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_IMPORT_USAGE]);
+    }
+
+    const char* manifest = argv[0];
+    FILE* f = str_eq(manifest, "-") ? stdin : fopen(manifest, "r");
+    if (!f) i0_perror(manifest);
+
+    i0_task_spec* specs = NULL;
+    size_t count = 0;
+    char line[8192];
+
+    // everything is read and checked before the first task is written
+    for (size_t line_no = 1; fgets(line, sizeof(line), f); line_no++) {
+        char* p = i0_trim(line);
+        if (*p == '\0' || *p == '#') continue;
+
+        const size_t len = strlen(p);
+        if (*p == '[' && p[len - 1] == ']') {
+            p[len - 1] = '\0';
+            p = i0_trim(p + 1);
+            if (!i0_name_ok(p)) {
+                i0_log(I0_LOG_CRITICAL, i0_lang[I0_LANG_IMPORT_BAD_LINE], manifest, line_no);
+            }
+
+            specs = realloc(specs, (count + 1) * sizeof(*specs));
+            if (!specs) i0_perror("realloc()");
+            specs[count] = (i0_task_spec){ .name = strdup(p) };
+            if (!specs[count++].name) i0_perror("strdup()");
+            continue;
+        }
+
+        char* eq = strchr(p, '=');
+        if (!eq || count == 0) {
+            i0_log(I0_LOG_CRITICAL, i0_lang[I0_LANG_IMPORT_BAD_LINE], manifest, line_no);
+        }
+        *eq = '\0';
+        i0_import_line(&specs[count - 1], manifest, line_no, i0_trim(p), i0_trim(eq + 1));
+    }
+    if (f != stdin) fclose(f);
+
+    for (size_t i = 0; i < count; i++) {
+        if (!specs[i].command || !specs[i].command[0]) {
+            i0_log(I0_LOG_CRITICAL, i0_lang[I0_LANG_IMPORT_NO_COMMAND], manifest, specs[i].name);
+        }
+    }
+
+    i0_string path;
+    for (size_t i = 0; i < count; i++) {
+        i0_task_install(&specs[i], 1, path);
+    }
+
+    i0_supervisor_reload();
+    i0_get_tasks_dir(path);
+    i0_log(I0_LOG_GOOD, i0_lang[I0_LANG_IMPORT_DONE], count, path);
+    return EXIT_SUCCESS;
+}
+
+static void i0_task_start(const char* task) {
+    i0_string pid_file;
+    i0_get_task_pid_file(pid_file, task);
+    pid_t pid = read_pid(pid_file);
+    if (pid > 0 && is_process_alive(pid)) {
+        char pidbuf[16];
+        snprintf(pidbuf, 16, "%d", pid);
+        i0_log(I0_LOG_WARNING, i0_lang[I0_LANG_STATUS_ALREADY_RUNNING], pidbuf);
+        return;
+    }
+
+    // a stale ./pid is left alone, the new one takes precedence
+    i0_get_task_runtime_file(pid_file, task, "pid");
+    fork_and_do(pid, i0_child_exec("./main", task), open_write_int(pid_file, pid));
+
+    i0_event_log(task, I0_EVENT_START, pid, 0, 0);
+    i0_log(I0_LOG_TASK_START, i0_lang[I0_LANG_STATUS_STARTED], task);
+}
+
+// "<script>.timeout" in the task dir, then the global timeout file. zero
+// or less would mean waiting forever, so those are ignored
+static long i0_script_timeout(const char* path) {
+    i0_string timeout;
+    i0_get_config_file(timeout, "timeout");
+    long def = read_long(timeout, I0_SCRIPT_TIMEOUT);
+    if (def <= 0) def = I0_SCRIPT_TIMEOUT;
+
+    snprintf(timeout, sizeof(timeout), "%s.timeout", path);
+    const long t = read_long(timeout, def);
+    return t > 0 ? t : def;
+}
+
+static int i0_run_script(const char* path, const char* task) {
+    return i0_run(path, task, i0_script_timeout(path) * 1000);
+}
+
+// a healthcheck is cut off at the deadline of whoever waits on it, 0 for
+// none, instead of running on for the whole script timeout
+static int i0_run_healthcheck(const char* path, const int64_t deadline) {
+    long timeout = i0_script_timeout(path) * 1000;
+    if (deadline) {
+        const int64_t left = (deadline - i0_clock_ns(CLOCK_MONOTONIC)) / 1000000;
+        if (left <= 0) return -1;
+        if (left < timeout) timeout = (long)left;
+    }
+    return i0_run(path, NULL, timeout);
+}
+
+static void i0_run_wait(const char* path, const char* task, const int error) {
+    if (i0_run_script(path, task) != 0) {
+        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[error]);
+    }
+}
+
+// into the task dir, with the task's runtime dir created and exported to
+// its scripts as $I0_RUNTIME_DIR
+static void i0_task_enter(const char* task, const char* path) {
+    if (chdir(path) != 0) {
+        i0_perror("chdir");
+    }
+
+    i0_string runtime;
+    i0_get_task_runtime_file(runtime, task, "");
+    if (try_mkdir_p(runtime) != 0) {
+        i0_perror(runtime);
+    }
+    setenv("I0_RUNTIME_DIR", runtime, 1);
+
+    i0_string self;
+    const ssize_t n = readlink("/proc/self/exe", self, sizeof(self) - 1);
+    if (n > 0) {
+        self[n] = '\0';
+        setenv("I0_BIN", self, 1);
+    }
+}
+
+// takes the per-task lock so concurrent i0 invocations never start or stop
+// the same task twice. the lock goes away with the returned fd. whoever
+// holds it is done within a start or stop script's timeout, or that script
+// got killed, so waiting longer than that means it is stuck
+static int i0_task_lock(const char* task, const char* path) {
+    i0_task_enter(task, path);
+
+    i0_string lock;
+    i0_get_task_runtime_file(lock, task, "lock");
+    const int fd = open(lock, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        i0_perror("open()");
+    }
+
+    const long start = i0_script_timeout("./start");
+    const long stop = i0_script_timeout("./stop");
+    const long timeout = start > stop ? start : stop;
+    const int64_t deadline = i0_clock_ns(CLOCK_MONOTONIC) + (int64_t)timeout * 1000000000;
+
+    for (int interval = 10; flock(fd, LOCK_EX | LOCK_NB) != 0; interval = interval < 500 ? interval * 2 : 500) {
+        if (errno != EWOULDBLOCK && errno != EINTR) i0_perror("flock()");
+        if (i0_clock_ns(CLOCK_MONOTONIC) >= deadline) {
+            i0_log(I0_LOG_CRITICAL, i0_lang[I0_LANG_ERROR_TASK_BUSY], task, timeout);
+        }
+        i0_sleep_ms(interval);
+    }
+
+    // the supervisor hands stored fds to children of whoever holds this
+    if (ftruncate(fd, 0) == 0) dprintf(fd, "%d\n", getpid());
+    return fd;
+}
+
+// a task is ready once its healthcheck script exits with 0. without
+// one it is ready once it survived I0_READY_GRACE
+static int i0_task_wait_ready(const char* task, const pid_t pid, const long timeout) {
+    // a zombie still answers kill(), so wait on the pid and reap it instead
+    if (!file_exists("./healthcheck")) return !i0_pid_wait(pid, I0_READY_GRACE, NULL);
+
+    char pidbuf[16];
+    snprintf(pidbuf, sizeof(pidbuf), "%d", pid);
+    setenv("I0_PID", pidbuf, 1);
+
+    const int64_t deadline = i0_clock_ns(CLOCK_MONOTONIC) + (int64_t)timeout * 1000000000;
+    for (int interval = 50;; interval = interval < 1000 ? interval * 2 : 1000) {
+        if (i0_run_healthcheck("./healthcheck", deadline) == 0) {
+            i0_event_log(task, I0_EVENT_HEALTH, pid, 0, 0);
+            return 1;
+        }
+        if (i0_pid_wait(pid, interval, NULL)) return 0;
+        if (i0_clock_ns(CLOCK_MONOTONIC) >= deadline) return 0;
+    }
+}
+
+static void i0_task_start_locked(const char* task) {
+    i0_string pid_file;
+    i0_get_task_pid_file(pid_file, task);
+    const pid_t old = read_pid(pid_file);
+    const int script = file_exists("./start");
+
+    if (script) {
+        i0_run_wait("./start", task, I0_LANG_ERROR_START_FAIL);
+    }
+    else if (file_exists("./main")) {
+        i0_task_start(task);
+    }
+    else {
+        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_ERROR_MAIN_NOT_FOUND]);
+    }
+
+    // readiness is up to `i0 wait --ready`, a start does not block on it
+    const pid_t pid = read_pid(pid_file);
+    if (script && pid > 0 && pid != old) i0_event_log(task, I0_EVENT_START, pid, 0, 0);
+}
+
+static void i0_task_start_script(const char* task, const char* path) {
+    const int lock = i0_task_lock(task, path);
+    i0_task_start_locked(task);
+    close(lock);
+}
+
+static void i0_task_stop(const char* task) {
+    i0_string pid_file;
+    i0_get_task_pid_file(pid_file, task);
+    const pid_t pid = read_pid(pid_file);
+    if (pid <= 0) {
+        i0_log(I0_LOG_WARNING, "%s", i0_lang[I0_LANG_STATUS_ALREADY_STOPPED]);
+        return;
+    }
+
+    if (!is_process_alive(pid)) {
+        unlink(pid_file);
+        i0_log(I0_LOG_WARNING, "%s", i0_lang[I0_LANG_STATUS_ALREADY_STOPPED]);
+        return;
+    }
+
+    const int sig = i0_kill_wait(pid, read_long("./kill.timeout", I0_KILL_TIMEOUT));
+    if (sig < 0) {
+        if (errno == ESRCH) {
+            unlink(pid_file);
+            i0_log(I0_LOG_WARNING, "%s", i0_lang[I0_LANG_STATUS_ALREADY_STOPPED]);
+        }
+        else {
+            i0_perror("kill()");
+        }
+        return;
+    }
+
+    unlink(pid_file);
+    i0_event_log(task, I0_EVENT_STOP, pid, sig, I0_EVENT_SIGNALED);
+    i0_log(I0_LOG_TASK_STOP, i0_lang[I0_LANG_STATUS_STOPPED], task);
+}
+
+static void i0_task_stop_locked(const char* task) {
+    if (file_exists("./stop")) {
+        i0_string pid_file;
+        i0_get_task_pid_file(pid_file, task);
+        const pid_t pid = read_pid(pid_file);
+        const int was_alive = pid > 0 && is_process_alive(pid);
+        i0_run_wait("./stop", NULL, I0_LANG_ERROR_STOP_FAIL);
+
+        if (was_alive && !is_process_alive(pid)) i0_event_log(task, I0_EVENT_STOP, pid, 0, 0);
+        return;
+    }
+
+    i0_task_stop(task);
+}
+
+static void i0_task_stop_script(const char* task, const char* path) {
+    const int lock = i0_task_lock(task, path);
+    i0_task_stop_locked(task);
+    close(lock);
+}
+
+static void i0_task_restart_script(const char* task, const char* path) {
+    const int lock = i0_task_lock(task, path);
+    i0_task_stop_locked(task);
+    i0_task_start_locked(task);
+
+    i0_string pid_file;
+    i0_get_task_pid_file(pid_file, task);
+    i0_event_log(task, I0_EVENT_RESTART, read_pid(pid_file), 0, 0);
+    close(lock);
+}
+
+// starts a second instance next to the running one and only stops the old
+// one once the new one is ready, so there is no moment without the service
+static void i0_task_handover_script(const char* task, const char* path) {
+    const int lock = i0_task_lock(task, path);
+    i0_string pid_file;
+    i0_get_task_pid_file(pid_file, task);
+    const pid_t old = read_pid(pid_file);
+
+    if (old <= 0 || !is_process_alive(old) || !file_exists("./main")) {
+        close(lock);
+        i0_task_restart_script(task, path);
+        return;
+    }
+
+    char oldbuf[16];
+    snprintf(oldbuf, sizeof(oldbuf), "%d", old);
+    setenv("I0_HANDOVER_PID", oldbuf, 1);
+
+    pid_t pid;
+    fork_and_do(pid, i0_child_exec("./main", task), (void)0);
+    unsetenv("I0_HANDOVER_PID");
+    i0_event_log(task, I0_EVENT_START, pid, 0, 0);
+
+    const long kill_timeout = read_long("./kill.timeout", I0_KILL_TIMEOUT);
+    if (!i0_task_wait_ready(task, pid, read_long("./ready.timeout", I0_READY_TIMEOUT))) {
+        const int sig = i0_kill_wait(pid, kill_timeout);
+        i0_event_log(task, I0_EVENT_STOP, pid, sig > 0 ? sig : 0, I0_EVENT_SIGNALED);
+        i0_log(I0_LOG_CRITICAL, i0_lang[I0_LANG_HANDOVER_FAILED], task, old);
+    }
+    i0_event_log(task, I0_EVENT_READY, pid, 0, 0);
+
+    open_write_int_atomic(pid_file, pid);
+
+    const int sig = i0_kill_wait(old, kill_timeout);
+    i0_event_log(task, I0_EVENT_STOP, old, sig > 0 ? sig : 0, I0_EVENT_SIGNALED);
+    i0_event_log(task, I0_EVENT_RESTART, pid, 0, 0);
+
+    char pidbuf[16];
+    snprintf(pidbuf, sizeof(pidbuf), "%d", pid);
+    i0_log(I0_LOG_TASK_START, i0_lang[I0_LANG_HANDOVER_DONE], task, pidbuf);
+    close(lock);
+}
+
+static void i0_task_status(const char* task) {
+    if (path_exists("./enabled")) i0_log(I0_LOG_GOOD, "%s", i0_lang[I0_LANG_STATUS_ENABLED]);
+
+    FILE* f = fopen("./description", "r");
+    if (f) {
+        char buffer[512] = {0};
+
+        // posix standard suggests each file to have \n in the end
+        // and that completely fucks up i0_log output
+        fread(buffer, 1, sizeof(buffer) - 1, f);
+
+        const size_t desc_len = strlen(buffer);
+        if (desc_len > 0 && buffer[desc_len - 1] == '\n') {
+            buffer[desc_len - 1] = '\0';
+        }
+
+        i0_log(I0_LOG_INFO, "%s: %s", i0_lang[I0_LANG_STATUS_DESCRIPTION], buffer);
+
+        fclose(f);
+    }
+
+    i0_string pid_file;
+    i0_get_task_pid_file(pid_file, task);
+    f = fopen(pid_file, "r");
+    if (f) {
+        pid_t pid;
+        if (fscanf(f, "%d", &pid) == 1 && is_process_alive(pid)) {
+            char pidbuf[16];
+            snprintf(pidbuf, 16, "%d", pid);
+            i0_log(I0_LOG_GOOD, i0_lang[I0_LANG_STATUS_RUNNING], pidbuf);
+
+            struct stat st;
+
+            if (stat(pid_file, &st) != 0) {
+                i0_perror("stat()");
+            }
+
+            struct tm* tm = localtime(&st.st_mtime);
+            if (!tm) {
+                i0_perror("localtime()");
+            }
+
+            char time_buf[64];
+            if (!strftime(time_buf, sizeof(time_buf), "%Y-%m-%d %H:%M:%S", tm)) {
+                i0_perror("strftime()");
+            }
+
+            i0_log(I0_LOG_GOOD, i0_lang[I0_LANG_STATUS_STARTED_AT], time_buf);
+        }
+        else goto not_running;
+        fclose(f);
+    }
+    else goto not_running;
+    return;
+    not_running:
+        i0_log(I0_LOG_BAD, "%s", i0_lang[I0_LANG_STATUS_NOT_RUNNING]);
+
+    i0_get_task_runtime_file(pid_file, task, "exit");
+    const long code = read_long(pid_file, -1);
+    if (code >= 0) i0_log(I0_LOG_INFO, i0_lang[I0_LANG_STATUS_LAST_EXIT], code);
+}
+
+static void i0_task_status_script(const char* task, const char* path) {
+    i0_task_enter(task, path);
+
+    if (file_exists("./status")) {
+        i0_run_wait("./status", NULL, I0_LANG_ERROR_STATUS_FAIL);
+        return;
+    }
+
+    i0_task_status(task);
+}
+
+#define i0_task_find_and_do(task, thing) do { \
+    i0_string path; \
+    i0_task_find(task, path); \
+    thing(task, path); \
+} while (0)
+
+// =========================================== //
+// batch operations                            //
+// =========================================== //
+
+// tasks with a `group` file share the limits of groups/<group>/starting
+// (how many may be starting at once) and groups/<group>/running (how many
+// may be starting or running at once). starts over a limit wait in line.
+// a limit below 1 would never let anything through, so it counts as 1
+
+typedef struct i0_group {
+    char* name;
+    long max_starting;
+    long max_running;
+    long starting;
+} i0_group;
+
+// what the supervisor can be asked to run, by name
+static const struct {
+    const char* name;
+    i0_task_action action;
+} i0_task_actions[] = {
+    { "start", i0_task_start_script },
+    { "stop", i0_task_stop_script },
+    { "restart", i0_task_restart_script },
+    { "handover", i0_task_handover_script },
+};
+
+static const char* i0_task_action_name(const i0_task_action action) {
+    for (size_t i = 0; i < sizeof(i0_task_actions) / sizeof(*i0_task_actions); i++) {
+        if (i0_task_actions[i].action == action) return i0_task_actions[i].name;
+    }
+    return NULL;
+}
+
+static i0_task_action i0_task_action_find(const char* name) {
+    for (size_t i = 0; i < sizeof(i0_task_actions) / sizeof(*i0_task_actions); i++) {
+        if (str_eq(i0_task_actions[i].name, name)) return i0_task_actions[i].action;
+    }
+    return NULL;
+}
+
+typedef struct i0_batch_job {
+    const char* task;
+    pid_t pid;
+    FILE* out;
+    int status;
+    int group;
+    int started;
+    int queued;
+} i0_batch_job;
+
+typedef struct i0_batch {
+    i0_string dir;
+    i0_batch_job* jobs;
+    size_t count;
+    size_t cap;
+    int failed;
+    int direct; // a single plain task: its output goes straight through
+
+    char** names; // the whole tasks dir, sorted
+    size_t name_count;
+    int use_groups;
+    int* name_group;
+    i0_group* groups;
+    size_t group_count;
+} i0_batch;
+
+static void i0_batch_add(i0_batch* b, const char* task) {
+    for (size_t i = 0; i < b->count; i++) {
+        if (str_eq(b->jobs[i].task, task)) return;
+    }
+
+    if (b->count == b->cap) {
+        b->cap = b->cap ? b->cap * 2 : 16;
+        b->jobs = realloc(b->jobs, b->cap * sizeof(*b->jobs));
+        if (!b->jobs) i0_perror("realloc()");
+    }
+    b->jobs[b->count++] = (i0_batch_job){ .task = task, .group = -1 };
+}
+
+static int i0_name_cmp(const void* a, const void* b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+// reads the tasks dir once and returns sorted task names
+static char** i0_batch_list(i0_batch* b, size_t* count) {
+    i0_get_tasks_dir(b->dir);
+    const size_t dir_len = strlen(b->dir);
+
+    char** names = NULL;
+    size_t cap = 0;
+    *count = 0;
+
+    DIR* d = opendir(b->dir);
+    if (!d) {
+        if (errno == ENOENT) return NULL;
+        i0_perror("opendir()");
+    }
+
+    struct dirent* dir;
+    while ((dir = readdir(d)) != NULL) {
+        if (dir->d_name[0] == '.') continue;
+
+        i0_string_append(b->dir, dir_len, dir->d_name, strlen(dir->d_name) + 1);
+        if (!dir_exists(b->dir)) continue;
+
+        if (*count == cap) {
+            cap = cap ? cap * 2 : 64;
+            names = realloc(names, cap * sizeof(*names));
+            if (!names) i0_perror("realloc()");
+        }
+        names[*count] = strdup(dir->d_name);
+        if (!names[*count]) i0_perror("strdup()");
+        (*count)++;
+    }
+    closedir(d);
+    b->dir[dir_len] = '\0';
+
+    qsort(names, *count, sizeof(*names), i0_name_cmp);
+    return names;
+}
+
+static int i0_task_enabled(i0_batch* b, const char* task) {
+    const size_t dir_len = strlen(b->dir);
+    const size_t task_len = strlen(task);
+    i0_string_append(b->dir, dir_len, task, task_len);
+    i0_string_append(b->dir, dir_len + task_len, "/enabled", conststrlen("/enabled") + 1);
+    const int enabled = path_exists(b->dir);
+    b->dir[dir_len] = '\0';
+    return enabled;
+}
+
+// reads groups/<name>/starting and groups/<name>/running for g->name
+static void i0_group_limits(i0_group* g) {
+    i0_string path;
+    i0_get_config_file(path, "groups/");
+    const size_t len = strlen(path) + strlen(g->name);
+    i0_string_append(path, strlen(path), g->name, strlen(g->name));
+    i0_string_append(path, len, "/starting", conststrlen("/starting") + 1);
+    g->max_starting = read_long(path, LONG_MAX);
+    i0_string_append(path, len, "/running", conststrlen("/running") + 1);
+    g->max_running = read_long(path, LONG_MAX);
+
+    if (g->max_starting < 1 || g->max_running < 1) {
+        i0_log(I0_LOG_WARNING, i0_lang[I0_LANG_GROUP_BAD_LIMIT], g->name);
+        if (g->max_starting < 1) g->max_starting = 1;
+        if (g->max_running < 1) g->max_running = 1;
+    }
+}
+
+static int i0_batch_group(i0_batch* b, const char* name) {
+    for (size_t i = 0; i < b->group_count; i++) {
+        if (str_eq(b->groups[i].name, name)) return (int)i;
+    }
+
+    b->groups = realloc(b->groups, (b->group_count + 1) * sizeof(*b->groups));
+    if (!b->groups) i0_perror("realloc()");
+
+    i0_group* g = &b->groups[b->group_count];
+    g->name = strdup(name);
+    if (!g->name) i0_perror("strdup()");
+    g->starting = 0;
+    i0_group_limits(g);
+
+    return (int)b->group_count++;
+}
+
+static void i0_batch_load_groups(i0_batch* b) {
+    b->name_group = malloc((b->name_count + 1) * sizeof(*b->name_group));
+    if (!b->name_group) i0_perror("malloc()");
+
+    const size_t dir_len = strlen(b->dir);
+    for (size_t i = 0; i < b->name_count; i++) {
+        char group[256];
+        const size_t len = dir_len + strlen(b->names[i]);
+        i0_string_append(b->dir, dir_len, b->names[i], strlen(b->names[i]));
+        i0_string_append(b->dir, len, "/group", conststrlen("/group") + 1);
+        read_word(b->dir, group, sizeof(group));
+        b->name_group[i] = group[0] ? i0_batch_group(b, group) : -1;
+    }
+    b->dir[dir_len] = '\0';
+
+    for (size_t i = 0; i < b->count; i++) {
+        char** name = bsearch(&b->jobs[i].task, b->names, b->name_count, sizeof(*b->names), i0_name_cmp);
+        b->jobs[i].group = name ? b->name_group[name - b->names] : -1;
+    }
+}
+
+static void i0_batch_resolve(i0_batch* b, const int argc, const char* argv[], const int enabled_only) {
+    b->names = i0_batch_list(b, &b->name_count);
+    char** names = b->names;
+    const size_t count = b->name_count;
+    int patterns = 0;
+
+    for (int i = 0; i < argc; i++) {
+        const char* pattern = argv[i];
+        patterns++;
+
+        if (!strpbrk(pattern, "*?[")) {
+            if (!bsearch(&pattern, names, count, sizeof(*names), i0_name_cmp)) {
+                i0_log(I0_LOG_WARNING, i0_lang[I0_LANG_BATCH_NOT_FOUND], pattern);
+                b->failed++;
+                continue;
+            }
+            if (!enabled_only || i0_task_enabled(b, pattern)) i0_batch_add(b, pattern);
+            continue;
+        }
+
+        for (size_t j = 0; j < count; j++) {
+            if (fnmatch(pattern, names[j], 0) != 0) continue;
+            if (!enabled_only || i0_task_enabled(b, names[j])) i0_batch_add(b, names[j]);
+        }
+    }
+
+    if (!patterns && enabled_only) {
+        for (size_t j = 0; j < count; j++) {
+            if (i0_task_enabled(b, names[j])) i0_batch_add(b, names[j]);
+        }
+    }
+
+    if (b->use_groups) i0_batch_load_groups(b);
+}
+
+// running tasks of group g that no worker of ours is busy with, their
+// pidfds are added to pfd when it is set
+static long i0_batch_group_running(i0_batch* b, const int g, struct pollfd* pfd, size_t* n) {
+    long running = 0;
+
+    for (size_t i = 0; i < b->name_count; i++) {
+        if (b->name_group[i] != g) continue;
+
+        int busy = 0;
+        for (size_t j = 0; j < b->count && !busy; j++) {
+            busy = b->jobs[j].pid > 0 && str_eq(b->jobs[j].task, b->names[i]);
+        }
+        if (busy) continue;
+
+        i0_string pid_file;
+        i0_get_task_pid_file(pid_file, b->names[i]);
+        const pid_t pid = read_pid(pid_file);
+        if (pid <= 0 || !is_process_alive(pid)) continue;
+
+        running++;
+        if (pfd && (pfd[*n].fd = i0_pidfd_open(pid)) >= 0) {
+            pfd[(*n)++].events = POLLIN;
+        }
+    }
+    return running;
+}
+
+static int i0_batch_admit(i0_batch* b, const i0_batch_job* job);
+
+static int i0_batch_any_admitted(i0_batch* b) {
+    for (size_t i = 0; i < b->count; i++) {
+        if (!b->jobs[i].started && i0_batch_admit(b, &b->jobs[i])) return 1;
+    }
+    return 0;
+}
+
+static int i0_batch_admit(i0_batch* b, const i0_batch_job* job) {
+    if (job->group < 0) return 1;
+
+    // already running, starting it again takes no slot
+    i0_string pid_file;
+    i0_get_task_pid_file(pid_file, job->task);
+    const pid_t pid = read_pid(pid_file);
+    if (pid > 0 && is_process_alive(pid)) return 1;
+
+    const i0_group* g = &b->groups[job->group];
+    if (g->starting >= g->max_starting) return 0;
+    if (g->max_running == LONG_MAX) return 1;
+    return g->starting + i0_batch_group_running(b, job->group, NULL, NULL) < g->max_running;
+}
+
+// nothing is starting and every job left waits for a running task of its
+// group to go away, so sleep until one does. the pidfds say so directly,
+// the journal (every stop and exit goes there) covers kernels without them
+static void i0_batch_wait_slot(i0_batch* b) {
+    struct pollfd* pfd = calloc(b->name_count + 2, sizeof(*pfd));
+    if (!pfd) i0_perror("calloc()");
+    size_t n = 0;
+
+    for (size_t g = 0; g < b->group_count; g++) {
+        for (size_t i = 0; i < b->count; i++) {
+            if (b->jobs[i].started || b->jobs[i].group != (int)g) continue;
+            i0_batch_group_running(b, (int)g, pfd, &n);
+            break;
+        }
+    }
+
+    i0_string events;
+    i0_get_events_dir(events);
+    const int ino = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (ino >= 0 && inotify_add_watch(ino, events, IN_MODIFY | IN_CREATE | IN_MOVED_TO) >= 0) {
+        pfd[n++] = (struct pollfd){ .fd = ino, .events = POLLIN };
+    }
+    else if (ino >= 0) {
+        close(ino);
+    }
+
+    // whatever was in the way may have gone while the fds were opened
+    if (!i0_batch_any_admitted(b)) {
+        while (poll(pfd, n, n ? -1 : 1000) < 0 && errno == EINTR) ;
+    }
+
+    for (size_t i = 0; i < n; i++) close(pfd[i].fd);
+    free(pfd);
+}
+
+static void i0_batch_child(i0_batch* b, i0_batch_job* job, const i0_task_action action) {
+    if (job->out) {
+        const int fd = fileno(job->out);
+        if (dup2(fd, STDOUT_FILENO) < 0 || dup2(fd, STDERR_FILENO) < 0) {
+            i0_perror("dup2()");
+        }
+    }
+
+    i0_string path;
+    const size_t dir_len = strlen(b->dir);
+    memcpy(path, b->dir, dir_len);
+    i0_string_append(path, dir_len, job->task, strlen(job->task) + 1);
+    action(job->task, path);
+    fflush(stdout);
+}
+
+// prints everything a finished job said in one piece
+static void i0_batch_output(i0_batch_job* job) {
+    if (!job->out) return;
+
+    i0_log(I0_LOG_INFO, i0_lang[I0_LANG_BATCH_TASK], job->task);
+    rewind(job->out);
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), job->out)) > 0) {
+        safe_fwrite(buf, n, stdout);
+    }
+    fflush(stdout);
+    fclose(job->out);
+    job->out = NULL;
+}
+
+static void i0_batch_reap(i0_batch* b) {
+    int status;
+    pid_t pid;
+    while ((pid = waitpid(-1, &status, 0)) < 0) {
+        if (errno != EINTR) i0_perror("waitpid()");
+    }
+
+    for (size_t i = 0; i < b->count; i++) {
+        i0_batch_job* job = &b->jobs[i];
+        if (job->pid != pid) continue;
+
+        job->pid = 0;
+        job->status = status;
+        if (job->group >= 0) b->groups[job->group].starting--;
+        i0_batch_output(job);
+        return;
+    }
+}
+
+static void i0_batch_buffer(i0_batch* b, i0_batch_job* job) {
+    // in memory, so a read-only root can still boot. without it the
+    // output just goes through unbuffered
+    if (b->direct) return;
+    const int fd = memfd_create("i0-batch", MFD_CLOEXEC);
+    job->out = fd >= 0 ? fdopen(fd, "w+") : NULL;
+    if (fd >= 0 && !job->out) close(fd);
+}
+
+// starts the first jobs in line that their group lets through, as long as
+// there are free workers
+static void i0_batch_run(i0_batch* b, const i0_task_action action, long parallel) {
+    long running = 0;
+    size_t left = b->count;
+    if (parallel < 1) parallel = 1;
+
+    while (left > 0 || running > 0) {
+        for (size_t i = 0; i < b->count && running < parallel; i++) {
+            i0_batch_job* job = &b->jobs[i];
+            if (job->started) continue;
+
+            if (!i0_batch_admit(b, job)) {
+                if (!job->queued) i0_log(I0_LOG_INFO, i0_lang[I0_LANG_GROUP_QUEUED], job->task, b->groups[job->group].name);
+                job->queued = 1;
+                continue;
+            }
+
+            job->started = 1;
+            left--;
+            if (job->group >= 0) b->groups[job->group].starting++;
+
+            i0_batch_buffer(b, job);
+            fflush(stdout);
+            fflush(stderr);
+            fork_and_do(job->pid, i0_batch_child(b, job, action), running++);
+        }
+
+        if (running > 0) {
+            i0_batch_reap(b);
+            running--;
+        }
+        else if (left > 0) {
+            i0_batch_wait_slot(b);
+        }
+    }
+}
+
+// with a supervisor running, starts and restarts are its to make: the task
+// becomes its child, so it gets reaped and followed like the ones it
+// started itself, and it waits in the same line for its group. our output
+// fds go along, the answer is the exit status of the supervisor's worker.
+// 0 if there is no supervisor to ask
+static int i0_batch_delegate(i0_batch* b, const i0_task_action action) {
+    const char* name = i0_task_action_name(action);
+    if (!name || action == i0_task_stop_script || b->count == 0) return 0;
+
+    // the worker logs the way we would
+    const char* log = getenv("I0_LOG");
+    if (!log || !log[0] || strlen(log) >= I0_LOG_NAME_MAX || strchr(log, ' ')) log = "auto";
+
+    struct pollfd* pfd = calloc(b->count, sizeof(*pfd));
+    if (!pfd) i0_perror("calloc()");
+    size_t left = 0;
+
+    for (size_t i = 0; i < b->count; i++) {
+        i0_batch_job* job = &b->jobs[i];
+        const int sock = i0_fdstore_connect();
+        if (sock < 0 && i == 0) {
+            free(pfd);
+            return 0;
+        }
+
+        job->started = 1;
+        job->status = W_EXITCODE(EXIT_FAILURE, 0);
+        pfd[i] = (struct pollfd){ .fd = -1, .events = POLLIN };
+        i0_batch_buffer(b, job);
+
+        char req[300];
+        const int out = job->out ? fileno(job->out) : STDOUT_FILENO;
+        const int fds[2] = { out, job->out ? out : STDERR_FILENO };
+        snprintf(req, sizeof(req), "%s %s %s", name, log, job->task);
+        fflush(stdout);
+        fflush(stderr);
+        if (sock >= 0 && i0_send_fds(sock, req, fds, 2) >= 0) {
+            pfd[i].fd = sock;
+            left++;
+        }
+        else if (sock >= 0) {
+            close(sock);
+        }
+    }
+
+    while (left > 0) {
+        if (poll(pfd, b->count, -1) < 0) {
+            if (errno == EINTR) continue;
+            i0_perror("poll()");
+        }
+
+        for (size_t i = 0; i < b->count; i++) {
+            if (pfd[i].fd < 0 || !pfd[i].revents) continue;
+            i0_batch_job* job = &b->jobs[i];
+
+            char reply[300];
+            int fds[I0_FDSTORE_MAX];
+            size_t n;
+            const ssize_t len = i0_recv_fds(pfd[i].fd, reply, sizeof(reply), fds, &n);
+            for (size_t j = 0; j < n; j++) close(fds[j]);
+            if (len < 0 && errno == EINTR) continue;
+
+            if (len > 0 && strncmp(reply, "queued ", 7) == 0) {
+                i0_log(I0_LOG_INFO, i0_lang[I0_LANG_GROUP_QUEUED], job->task, reply + 7);
+                continue;
+            }
+            if (len > 0 && strncmp(reply, "exit ", 5) == 0) {
+                job->status = W_EXITCODE(atoi(reply + 5) & 0xff, 0);
+            }
+            close(pfd[i].fd);
+            pfd[i].fd = -1;
+            left--;
+            i0_batch_output(job);
+        }
+    }
+    free(pfd);
+    return 1;
+}
+
+static void i0_batch_report(i0_batch* b) {
+    for (size_t i = 0; i < b->count; i++) {
+        const i0_batch_job* job = &b->jobs[i];
+        if (WIFEXITED(job->status) && WEXITSTATUS(job->status) == 0) {
+            if (!b->direct) i0_log(I0_LOG_GOOD, i0_lang[I0_LANG_BATCH_OK], job->task);
+        }
+        else {
+            i0_log(I0_LOG_BAD, i0_lang[I0_LANG_BATCH_FAILED], job->task);
+            b->failed++;
+        }
+    }
+}
+
+// i0 <command> [-j N] [--enabled] [--handover] [task or glob]...
+// a single plain task name prints like it always did, but still runs in
+// a worker so its result counts. -j does not apply to what the
+// supervisor runs, it has its own limit
+static int i0_batch_main(const int argc, const char* argv[], i0_task_action action, const int no_arg_error) {
+    const char** targets = malloc((size_t)(argc + 1) * sizeof(*targets));
+    if (!targets) i0_perror("malloc()");
+
+    int count = 0;
+    int enabled_only = 0;
+    long parallel = sysconf(_SC_NPROCESSORS_ONLN);
+
+    for (int i = 0; i < argc; i++) {
+        if (str_eq(argv[i], "--enabled")) {
+            enabled_only = 1;
+        }
+        else if (str_eq(argv[i], "-j") || str_eq(argv[i], "--jobs")) {
+            if (++i == argc || (parallel = strtol(argv[i], NULL, 10)) <= 0) {
+                i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_BATCH_BAD_JOBS]);
+            }
+        }
+        else if (str_eq(argv[i], "--handover") && action == i0_task_restart_script) {
+            action = i0_task_handover_script;
+        }
+        else if (argv[i][0] == '-') {
+            i0_log(I0_LOG_CRITICAL, i0_lang[I0_LANG_ERROR_UNKNOWN_OPTION], argv[i]);
+        }
+        else {
+            targets[count++] = argv[i];
+        }
+    }
+
+    if (count == 0 && !enabled_only) {
+        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[no_arg_error]);
+    }
+
+    i0_batch b = {0};
+    if (count == 1 && !enabled_only && !strpbrk(targets[0], "*?[")) {
+        i0_string path;
+        i0_task_find(targets[0], path);
+        b.direct = 1;
+    }
+
+    b.use_groups = action != i0_task_stop_script && action != i0_task_status_script;
+    i0_batch_resolve(&b, count, targets, enabled_only);
+    if (!i0_batch_delegate(&b, action)) i0_batch_run(&b, action, parallel);
+    i0_batch_report(&b);
+    return b.failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// one task in a worker of the supervisor, which already made room for it
+// in its group
+static int i0_batch_one(const char* task, const i0_task_action action) {
+    i0_batch b = {0};
+    b.direct = 1;
+    i0_batch_resolve(&b, 1, &task, 0);
+    i0_batch_run(&b, action, 1);
+    i0_batch_report(&b);
+    return b.failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// every enabled task, in parallel and within the limits of their groups.
+// a failing or hung start only takes its own worker down
+static void i0_boot_scan() {
+    i0_batch b = {0};
+    b.use_groups = 1;
+    i0_batch_resolve(&b, 0, NULL, 1);
+    i0_batch_run(&b, i0_task_start_script, sysconf(_SC_NPROCESSORS_ONLN));
+    i0_batch_report(&b);
+}
+
+_Noreturn static void i0_boot() {
+    i0_log(I0_LOG_INFO, "%s", i0_lang[I0_LANG_BOOT_START]);
+    i0_boot_scan();
+
+    i0_log(I0_LOG_INFO, "%s", i0_lang[I0_LANG_BOOT_END]);
+    exit(EXIT_SUCCESS);
+}
+
+// =========================================== //
+// supervisor                                  //
+// =========================================== //
+
+// `i0 supervise` stays resident as a child subreaper. whatever a task forks
+// and abandons is reparented to us, so zombies get reaped and a task that
+// daemonizes keeps being tracked through its surviving process
+
+// under memory pressure tasks with a negative `priority` file are shed
+// lowest first, either stopped or frozen as their `shed` file says. once
+// no pressure trigger fired for a while they come back one by one
+
+#define I0_PSI_TRIGGER "some 150000 2000000"
+#define I0_PSI_CALM_SECONDS 30
+
+typedef struct i0_shed_task {
+    char* task;
+    int frozen;
+} i0_shed_task;
+
+typedef struct i0_stored_fd {
+    char* task;
+    char* name;
+    int fd;
+} i0_stored_fd;
+
+// a task with a `watch` file is started when one of the listed paths sees
+// one of its events, one "<path> [event,...]" per line. the path that
+// fired is in $I0_TRIGGER_PATH. events closer than `watch.delay` ms are
+// folded into one start, though a path that never stops changing still
+// gets one every I0_WATCH_MAX_DELAY_MS. a trigger that fires while the task
+// still runs starts it again once it exits
+
+#define I0_WATCH_EVENTS (IN_CLOSE_WRITE | IN_MOVED_TO)
+#define I0_WATCH_DELAY_MS 500
+#define I0_WATCH_MAX_DELAY_MS 10000
+
+typedef struct i0_watch {
+    int wd;
+    uint32_t mask;
+    char* path;
+    size_t trigger;
+} i0_watch;
+
+typedef struct i0_trigger {
+    char* task;
+    char* path; // what fired last, NULL when nothing is pending
+    int64_t due; // 0 while waiting for the task to exit
+    int64_t since; // first event of what is pending
+    long delay_ms;
+    int pidfd; // the task when someone else started it, it is no child of ours
+} i0_trigger;
+
+// a task with an `idle.timeout` file (seconds) is stopped the normal way
+// once it has used next to no cpu for that long, its cgroup's cpu.stat or
+// its own /proc/<pid>/stat. a watch trigger brings it back
+
+// cpu use up to this share (per mille of one cpu) between two samples is
+// still idle, timers and keepalives should not keep a task up
+#define I0_IDLE_CPU_PERMILLE 10
+
+typedef struct i0_idle {
+    char* task;
+    long timeout;
+    pid_t pid;
+    long long cpu_usec;
+    int64_t sampled_at;
+    int64_t active_at;
+} i0_idle;
+
+// every start and stop the supervisor makes runs in a worker of its own,
+// in the order they were asked for. group limits are counted here over all
+// of them: a start only leaves the line once its group has room, and no
+// task has two workers at once
+
+typedef struct i0_sv_job {
+    char* task;
+    char* trigger; // $I0_TRIGGER_PATH when a watch fired
+    i0_task_action action;
+    pid_t pid; // the worker, 0 while in line
+    int queued; // the wait was logged
+    int client; // an `i0 start` waiting for the result, -1 for our own jobs
+    int out; // its stdout and stderr for the worker, -1 for ours
+    int err;
+    char log[I0_LOG_NAME_MAX]; // and its $I0_LOG
+} i0_sv_job;
+
+typedef struct i0_ctl_client {
+    int fd;
+    int64_t deadline;
+} i0_ctl_client;
+
+typedef struct i0_sv {
+    i0_string dir;
+    int sigfd;
+    int ctl;
+    i0_ctl_client clients[I0_CTL_CLIENTS];
+    size_t client_count;
+    i0_stored_fd* fds;
+    size_t fd_count;
+    size_t fd_cap;
+    int psi[2]; // system wide and i0 cgroup memory pressure triggers
+    i0_shed_task* shed;
+    size_t shed_count;
+    size_t shed_cap;
+    int64_t calm_at;
+    int ino;
+    i0_watch* watches;
+    size_t watch_count;
+    size_t watch_cap;
+    i0_trigger* triggers;
+    size_t trigger_count;
+    size_t trigger_cap;
+    i0_idle* idle;
+    size_t idle_count;
+    size_t idle_cap;
+    int64_t idle_check_at;
+    i0_sv_job* jobs;
+    size_t job_count;
+    size_t job_cap;
+    int events; // inotify on the journal, every stop and exit goes there
+} i0_sv;
+
+static i0_trigger* i0_sv_trigger_new(i0_sv* sv) {
+    if (sv->trigger_count == sv->trigger_cap) {
+        sv->trigger_cap = sv->trigger_cap ? sv->trigger_cap * 2 : 8;
+        sv->triggers = realloc(sv->triggers, sv->trigger_cap * sizeof(*sv->triggers));
+        if (!sv->triggers) i0_perror("realloc()");
+    }
+    return &sv->triggers[sv->trigger_count++];
+}
+
+static i0_idle* i0_sv_idle_new(i0_sv* sv) {
+    if (sv->idle_count == sv->idle_cap) {
+        sv->idle_cap = sv->idle_cap ? sv->idle_cap * 2 : 8;
+        sv->idle = realloc(sv->idle, sv->idle_cap * sizeof(*sv->idle));
+        if (!sv->idle) i0_perror("realloc()");
+    }
+    return &sv->idle[sv->idle_count++];
+}
+
+static int proc_stat(const pid_t pid, char* state, pid_t* ppid) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    FILE* f = fopen(path, "r");
+    if (!f) return -1;
+
+    char buf[512];
+    const size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    buf[n] = '\0';
+
+    // comm may contain anything including ") ", the last one ends it
+    const char* p = strrchr(buf, ')');
+    return p && sscanf(p + 1, " %c %d", state, ppid) == 2 ? 0 : -1;
+}
+
+static pid_t proc_ppid(const pid_t pid) {
+    char state;
+    pid_t ppid;
+    return proc_stat(pid, &state, &ppid) == 0 ? ppid : 0;
+}
+
+// exited, but whoever it was reparented to has not reaped it yet
+static int proc_zombie(const pid_t pid) {
+    char state;
+    pid_t ppid;
+    return proc_stat(pid, &state, &ppid) == 0 && state == 'Z';
+}
+
+static int proc_task_from_cgroup(const pid_t pid, char* task, const size_t size) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/cgroup", pid);
+    FILE* f = fopen(path, "r");
+    if (!f) return -1;
+
+    char line[512];
+    int found = -1;
+    while (found != 0 && fgets(line, sizeof(line), f)) {
+        const char* p;
+        if (strncmp(line, "0::", 3) != 0 || !(p = strstr(line, "/i0/"))) continue;
+        p += conststrlen("/i0/");
+
+        const size_t len = strcspn(p, "/\n");
+        if (len == 0 || len >= size) continue;
+        memcpy(task, p, len);
+        task[len] = '\0';
+        found = 0;
+    }
+    fclose(f);
+    return found;
+}
+
+static int proc_task_from_environ(const pid_t pid, char* task, const size_t size) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/environ", pid);
+    FILE* f = fopen(path, "r");
+    if (!f) return -1;
+
+    static char buf[64 * 1024];
+    const size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    buf[n] = '\0';
+
+    for (const char* p = buf; p < buf + n; p += strlen(p) + 1) {
+        if (strncmp(p, "I0_TASK=", conststrlen("I0_TASK=")) != 0) continue;
+        p += conststrlen("I0_TASK=");
+        if (strlen(p) >= size) return -1;
+        strcpy(task, p);
+        return 0;
+    }
+    return -1;
+}
+
+// which task a process belongs to, by its cgroup first and by the
+// I0_TASK variable it inherited otherwise
+static int proc_task(const pid_t pid, char* task, const size_t size) {
+    if (proc_task_from_cgroup(pid, task, size) == 0) return 0;
+    return proc_task_from_environ(pid, task, size);
+}
+
+// a reparented child of ours that still belongs to task
+static pid_t i0_sv_find_heir(const char* task, const pid_t dead) {
+    DIR* d = opendir("/proc");
+    if (!d) return 0;
+
+    const pid_t self = getpid();
+    pid_t heir = 0;
+    struct dirent* dir;
+    while (!heir && (dir = readdir(d)) != NULL) {
+        char* end;
+        const pid_t pid = (pid_t)strtol(dir->d_name, &end, 10);
+        if (*end != '\0' || pid <= 0 || pid == dead) continue;
+        if (proc_ppid(pid) != self) continue;
+
+        char owner[256];
+        if (proc_task(pid, owner, sizeof(owner)) == 0 && str_eq(owner, task)) heir = pid;
+    }
+    closedir(d);
+    return heir;
+}
+
+// finds the task whose pid file points at pid
+static int i0_sv_find_task(i0_sv* sv, const pid_t pid, char** task) {
+    DIR* d = opendir(sv->dir);
+    if (!d) return -1;
+
+    struct dirent* dir;
+    while ((dir = readdir(d)) != NULL) {
+        if (dir->d_name[0] == '.') continue;
+
+        i0_string path;
+        i0_get_task_pid_file(path, dir->d_name);
+        if (read_pid(path) != pid) continue;
+
+        *task = strdup(dir->d_name);
+        closedir(d);
+        return *task ? 0 : -1;
+    }
+    closedir(d);
+    return -1;
+}
+
+static void i0_sv_task_exited(const char* task, const pid_t pid, const int status) {
+    i0_string path;
+    i0_get_task_runtime_file(path, task, "lock");
+
+    // whoever holds the lock is starting or stopping the task right now
+    // and will take care of the pid file
+    const int lock = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    const int locked = lock >= 0 && flock(lock, LOCK_EX | LOCK_NB) == 0;
+    i0_get_task_pid_file(path, task);
+
+    const pid_t heir = i0_sv_find_heir(task, pid);
+    if (heir > 0) {
+        if (locked) try_write_int(path, heir);
+        i0_log(I0_LOG_INFO, i0_lang[I0_LANG_SUPERVISE_ADOPTED], task, heir);
+    }
+    else {
+        if (locked) unlink(path);
+
+        // the shell's way of telling a signal from an exit code
+        i0_get_task_runtime_file(path, task, "exit");
+        try_write_int(path, WIFSIGNALED(status) ? 128 + WTERMSIG(status) : WEXITSTATUS(status));
+
+        if (WIFSIGNALED(status)) {
+            i0_event_log(task, I0_EVENT_EXIT, pid, WTERMSIG(status), I0_EVENT_SIGNALED);
+            i0_log(I0_LOG_BAD, i0_lang[I0_LANG_SUPERVISE_KILLED], task, WTERMSIG(status));
+        }
+        else {
+            i0_event_log(task, I0_EVENT_EXIT, pid, WEXITSTATUS(status), 0);
+            i0_log(I0_LOG_BAD, i0_lang[I0_LANG_SUPERVISE_EXITED], task, WEXITSTATUS(status));
+        }
+    }
+    if (lock >= 0) close(lock);
+}
+
+// something exited, triggers that waited for their task get another look
+static void i0_sv_watch_exited(i0_sv* sv) {
+    const int64_t now = i0_clock_ns(CLOCK_MONOTONIC);
+
+    for (size_t i = 0; i < sv->trigger_count; i++) {
+        i0_trigger* t = &sv->triggers[i];
+        if (t->path && !t->due) t->due = now;
+    }
+}
+
+static void i0_sv_task_path(i0_sv* sv, const char* task, const char* file, i0_string path) {
+    const size_t dir_len = strlen(sv->dir);
+    const size_t task_len = strlen(task);
+    memcpy(path, sv->dir, dir_len);
+    i0_string_append(path, dir_len, task, task_len);
+    i0_string_append(path, dir_len + task_len, file, strlen(file) + 1);
+}
+
+static i0_sv_job* i0_sv_job_find(i0_sv* sv, const char* task) {
+    for (size_t i = 0; i < sv->job_count; i++) {
+        if (str_eq(sv->jobs[i].task, task)) return &sv->jobs[i];
+    }
+    return NULL;
+}
+
+// puts a start or stop in line, see i0_sv_run_jobs()
+static i0_sv_job* i0_sv_spawn(i0_sv* sv, const char* task, const i0_task_action action, const char* trigger) {
+    if (sv->job_count == sv->job_cap) {
+        sv->job_cap = sv->job_cap ? sv->job_cap * 2 : 16;
+        sv->jobs = realloc(sv->jobs, sv->job_cap * sizeof(*sv->jobs));
+        if (!sv->jobs) i0_perror("realloc()");
+    }
+
+    i0_sv_job* job = &sv->jobs[sv->job_count++];
+    *job = (i0_sv_job){
+        .task = strdup(task),
+        .trigger = trigger ? strdup(trigger) : NULL,
+        .action = action,
+        .client = -1,
+        .out = -1,
+        .err = -1
+    };
+    if (!job->task || (trigger && !job->trigger)) i0_perror("strdup()");
+    return job;
+}
+
+static void i0_sv_task_group(i0_sv* sv, const char* task, char* group, const size_t size) {
+    i0_string path;
+    i0_sv_task_path(sv, task, "/group", path);
+    read_word(path, group, size);
+}
+
+// members of group that a worker of ours is starting, and the others that run
+static void i0_sv_group_count(i0_sv* sv, const char* group, long* starting, long* running) {
+    *starting = 0;
+    *running = 0;
+
+    DIR* d = opendir(sv->dir);
+    struct dirent* dir;
+    while (d && (dir = readdir(d)) != NULL) {
+        if (dir->d_name[0] == '.') continue;
+
+        char name[256];
+        i0_sv_task_group(sv, dir->d_name, name, sizeof(name));
+        if (!str_eq(name, group)) continue;
+
+        const i0_sv_job* job = i0_sv_job_find(sv, dir->d_name);
+        if (job && job->pid > 0 && job->action != i0_task_stop_script) {
+            (*starting)++;
+            continue;
+        }
+
+        i0_string path;
+        i0_get_task_pid_file(path, dir->d_name);
+        const pid_t pid = read_pid(path);
+        if (pid > 0 && is_process_alive(pid) && !proc_zombie(pid)) (*running)++;
+    }
+    if (d) closedir(d);
+}
+
+// 1 when the job may go now, 0 when it waits and -1 when its group is full
+static int i0_sv_admit(i0_sv* sv, const i0_sv_job* job, const long workers, char* group, const size_t size) {
+    for (size_t i = 0; i < sv->job_count; i++) {
+        if (sv->jobs[i].pid > 0 && str_eq(sv->jobs[i].task, job->task)) return 0;
+    }
+    if (job->action == i0_task_stop_script) return 1;
+    if (workers <= 0) return 0;
+
+    i0_sv_task_group(sv, job->task, group, size);
+    if (!group[0]) return 1;
+
+    // already running, starting it again takes no slot
+    i0_string path;
+    i0_get_task_pid_file(path, job->task);
+    const pid_t pid = read_pid(path);
+    if (pid > 0 && is_process_alive(pid)) return 1;
+
+    // the limit files are read again, editing them needs no reload
+    long starting, running;
+    i0_group g = { .name = group };
+    i0_group_limits(&g);
+    i0_sv_group_count(sv, group, &starting, &running);
+    if (starting >= g.max_starting || starting + running >= g.max_running) return -1;
+    return 1;
+}
+
+_Noreturn static void i0_sv_worker(const i0_sv_job* job) {
+    if (job->out >= 0) {
+        if (dup2(job->out, STDOUT_FILENO) < 0 || dup2(job->err, STDERR_FILENO) < 0) {
+            i0_perror("dup2()");
+        }
+        if (str_eq(job->log, "auto")) unsetenv("I0_LOG");
+        else setenv("I0_LOG", job->log, 1);
+        i0_log_fmt = I0_LOG_FORMAT_AUTO;
+        i0_log_init();
+    }
+    if (job->trigger) setenv("I0_TRIGGER_PATH", job->trigger, 1);
+    _exit(i0_batch_one(job->task, job->action));
+}
+
+static void i0_sv_job_close(i0_sv_job* job) {
+    if (job->out >= 0) close(job->out);
+    if (job->err >= 0) close(job->err);
+    job->out = job->err = -1;
+}
+
+// forks a worker for every job in line that may go. starts take one of
+// as many workers as there are cpus, stops never wait for one
+static void i0_sv_run_jobs(i0_sv* sv) {
+    long workers = sysconf(_SC_NPROCESSORS_ONLN);
+    for (size_t i = 0; i < sv->job_count; i++) {
+        if (sv->jobs[i].pid > 0 && sv->jobs[i].action != i0_task_stop_script) workers--;
+    }
+
+    for (size_t i = 0; i < sv->job_count; i++) {
+        i0_sv_job* job = &sv->jobs[i];
+        if (job->pid > 0) continue;
+
+        char group[256];
+        const int admit = i0_sv_admit(sv, job, workers, group, sizeof(group));
+        if (admit < 0 && !job->queued) {
+            i0_log(I0_LOG_INFO, i0_lang[I0_LANG_GROUP_QUEUED], job->task, group);
+            if (job->client >= 0) {
+                char msg[300];
+                snprintf(msg, sizeof(msg), "queued %s", group);
+                i0_send_fds(job->client, msg, NULL, 0);
+            }
+            job->queued = 1;
+        }
+        if (admit <= 0) continue;
+
+        if (job->action != i0_task_stop_script) workers--;
+        fflush(stdout);
+        fflush(stderr);
+        fork_and_do(job->pid, i0_sv_worker(job), i0_sv_job_close(job));
+    }
+}
+
+// drops the job whose worker this was, keeping the rest in line
+static int i0_sv_job_exited(i0_sv* sv, const pid_t pid, const int status) {
+    for (size_t i = 0; i < sv->job_count; i++) {
+        if (sv->jobs[i].pid != pid) continue;
+
+        if (sv->jobs[i].client >= 0) {
+            char msg[32];
+            snprintf(msg, sizeof(msg), "exit %d", WIFSIGNALED(status) ? 128 + WTERMSIG(status) : WEXITSTATUS(status));
+            i0_send_fds(sv->jobs[i].client, msg, NULL, 0);
+            close(sv->jobs[i].client);
+        }
+        i0_sv_job_close(&sv->jobs[i]);
+        free(sv->jobs[i].task);
+        free(sv->jobs[i].trigger);
+        memmove(&sv->jobs[i], &sv->jobs[i + 1], (sv->job_count - i - 1) * sizeof(*sv->jobs));
+        sv->job_count--;
+        return 1;
+    }
+    return 0;
+}
+
+static void i0_sv_reap(i0_sv* sv) {
+    int status;
+    pid_t pid;
+    while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+        i0_sv_watch_exited(sv);
+        if (i0_sv_job_exited(sv, pid, status)) continue;
+
+        char* task;
+        if (i0_sv_find_task(sv, pid, &task) != 0) continue;
+
+        i0_sv_task_exited(task, pid, status);
+        free(task);
+    }
+    // whatever exited may have made room in a group
+    i0_sv_run_jobs(sv);
+}
+
+// a stop or exit outside of our children, e.g. of a task that was running
+// before we came up
+static void i0_sv_events_read(i0_sv* sv) {
+    char buf[4096];
+    while (read(sv->events, buf, sizeof(buf)) > 0) ;
+    i0_sv_run_jobs(sv);
+}
+
+static void i0_sv_events_setup(i0_sv* sv) {
+    i0_string path;
+    i0_get_events_dir(path);
+    sv->events = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (sv->events >= 0 && inotify_add_watch(sv->events, path, IN_MODIFY | IN_CREATE | IN_MOVED_TO) < 0) {
+        close(sv->events);
+        sv->events = -1;
+    }
+}
+
+// every enabled task, in line like any other start
+static void i0_sv_boot(i0_sv* sv) {
+    i0_batch b = {0};
+    i0_batch_resolve(&b, 0, NULL, 1);
+    for (size_t i = 0; i < b.count; i++) i0_sv_spawn(sv, b.jobs[i].task, i0_task_start_script, NULL);
+
+    for (size_t i = 0; i < b.name_count; i++) free(b.names[i]);
+    free(b.names);
+    free(b.jobs);
+    i0_sv_run_jobs(sv);
+}
+
+static int i0_cgroup_write(const char* task, const char* file, const char* value) {
+    i0_string path;
+    if (i0_cgroup_path(task, file, path) != 0) return -1;
+
+    const int fd = open(path, O_WRONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+    const ssize_t len = (ssize_t)strlen(value);
+    const int ret = write(fd, value, (size_t)len) == len ? 0 : -1;
+    close(fd);
+    return ret;
+}
+
+static int i0_psi_open(const char* path, const char* trigger) {
+    const int fd = open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd >= 0 && write(fd, trigger, strlen(trigger) + 1) >= 0) return fd;
+
+    i0_log(I0_LOG_WARNING, i0_lang[I0_LANG_PSI_ARM_FAILED], path, strerror(errno));
+    if (fd >= 0) close(fd);
+    return -1;
+}
+
+static void i0_sv_psi_setup(i0_sv* sv) {
+    i0_string path;
+    char trigger[128];
+    i0_get_config_file(path, "pressure");
+
+    FILE* f = fopen(path, "r");
+    if (!f || !fgets(trigger, sizeof(trigger), f)) {
+        strcpy(trigger, I0_PSI_TRIGGER);
+    }
+    if (f) fclose(f);
+    trigger[strcspn(trigger, "\n")] = '\0';
+
+    sv->psi[0] = i0_psi_open("/proc/pressure/memory", trigger);
+    sv->psi[1] = -1;
+    if (i0_cgroup_path("", "", path) == 0) {
+        // tasks create it on their first start, which may not have happened
+        if (mkdir(path, 0755) != 0 && errno != EEXIST) {
+            i0_log(I0_LOG_WARNING, i0_lang[I0_LANG_PSI_ARM_FAILED], path, strerror(errno));
+            return;
+        }
+        i0_string_append(path, strlen(path), "memory.pressure", conststrlen("memory.pressure") + 1);
+        sv->psi[1] = i0_psi_open(path, trigger);
+    }
+}
+
+static int i0_sv_is_shed(i0_sv* sv, const char* task) {
+    for (size_t i = 0; i < sv->shed_count; i++) {
+        if (str_eq(sv->shed[i].task, task)) return 1;
+    }
+    return 0;
+}
+
+// the running task with the lowest negative priority that is not shed yet
+static char* i0_sv_shed_victim(i0_sv* sv) {
+    DIR* d = opendir(sv->dir);
+    if (!d) return NULL;
+
+    char* victim = NULL;
+    long victim_priority = 0;
+
+    struct dirent* dir;
+    while ((dir = readdir(d)) != NULL) {
+        if (dir->d_name[0] == '.') continue;
+
+        i0_string path;
+        i0_sv_task_path(sv, dir->d_name, "/priority", path);
+        const long priority = read_long(path, 0);
+        if (priority >= victim_priority || i0_sv_is_shed(sv, dir->d_name)) continue;
+
+        i0_get_task_pid_file(path, dir->d_name);
+        const pid_t pid = read_pid(path);
+        if (pid <= 0 || !is_process_alive(pid)) continue;
+
+        free(victim);
+        victim = strdup(dir->d_name);
+        victim_priority = priority;
+    }
+    closedir(d);
+    return victim;
+}
+
+static void i0_sv_shed(i0_sv* sv) {
+    char* task = i0_sv_shed_victim(sv);
+    sv->calm_at = i0_clock_ns(CLOCK_MONOTONIC) + (int64_t)I0_PSI_CALM_SECONDS * 1000000000;
+    if (!task) return;
+
+    i0_string path;
+    char mode[16];
+    i0_sv_task_path(sv, task, "/shed", path);
+    read_word(path, mode, sizeof(mode));
+
+    // freezing keeps the memory but stops the allocations, it needs a cgroup
+    const int frozen = str_eq(mode, "freeze") && i0_cgroup_write(task, "cgroup.freeze", "1") == 0;
+    if (frozen) {
+        i0_log(I0_LOG_WARNING, i0_lang[I0_LANG_PSI_FREEZE], task);
+    }
+    else {
+        i0_log(I0_LOG_WARNING, i0_lang[I0_LANG_PSI_SHED], task);
+        i0_sv_spawn(sv, task, i0_task_stop_script, NULL);
+        i0_sv_run_jobs(sv);
+    }
+
+    if (sv->shed_count == sv->shed_cap) {
+        sv->shed_cap = sv->shed_cap ? sv->shed_cap * 2 : 8;
+        sv->shed = realloc(sv->shed, sv->shed_cap * sizeof(*sv->shed));
+        if (!sv->shed) i0_perror("realloc()");
+    }
+    sv->shed[sv->shed_count++] = (i0_shed_task){ .task = task, .frozen = frozen };
+}
+
+// brings back the most recently shed task
+static void i0_sv_unshed(i0_sv* sv) {
+    const i0_shed_task shed = sv->shed[--sv->shed_count];
+    sv->calm_at = sv->shed_count ? i0_clock_ns(CLOCK_MONOTONIC) + (int64_t)I0_PSI_CALM_SECONDS * 1000000000 : 0;
+
+    i0_log(I0_LOG_INFO, i0_lang[I0_LANG_PSI_RESTORE], shed.task);
+    if (shed.frozen) {
+        i0_cgroup_write(shed.task, "cgroup.freeze", "0");
+    }
+    else {
+        i0_sv_spawn(sv, shed.task, i0_task_start_script, NULL);
+        i0_sv_run_jobs(sv);
+    }
+    free(shed.task);
+}
+
+// for whoever wants to `kill -HUP` us after editing watch files
+static void i0_sv_pid_setup() {
+    i0_string path;
+    i0_get_runtime_dir(path);
+    if (try_mkdir_p(path) != 0) return;
+    i0_string_append(path, strlen(path), I0_SUPERVISOR_PID, conststrlen(I0_SUPERVISOR_PID) + 1);
+    try_write_int_atomic(path, getpid());
+}
+
+static void i0_sv_ctl_setup(i0_sv* sv) {
+    struct sockaddr_un addr;
+    i0_string dir;
+    i0_get_runtime_dir(dir);
+    sv->ctl = -1;
+    if (try_mkdir_p(dir) != 0 || i0_fdstore_addr(&addr) != 0) return;
+
+    sv->ctl = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (sv->ctl < 0) return;
+
+    unlink(addr.sun_path);
+    const mode_t mask = umask(0077);
+    const int bound = bind(sv->ctl, (struct sockaddr*)&addr, sizeof(addr)) == 0;
+    umask(mask);
+    if (!bound || listen(sv->ctl, 16) != 0) {
+        i0_log(I0_LOG_WARNING, "%s: %s", addr.sun_path, strerror(errno));
+        close(sv->ctl);
+        sv->ctl = -1;
+    }
+}
+
+static void i0_sv_fd_drop(i0_sv* sv, const size_t i) {
+    close(sv->fds[i].fd);
+    free(sv->fds[i].task);
+    free(sv->fds[i].name);
+    sv->fds[i] = sv->fds[--sv->fd_count];
+}
+
+static int i0_sv_fd_find(i0_sv* sv, const char* task, const char* name) {
+    for (size_t i = 0; i < sv->fd_count; i++) {
+        if (str_eq(sv->fds[i].task, task) && str_eq(sv->fds[i].name, name)) return (int)i;
+    }
+    return -1;
+}
+
+static int i0_sv_fd_store(i0_sv* sv, const char* task, const char* name, const int fd) {
+    if (!i0_state_ok(task)) return -1;
+    const int old = i0_sv_fd_find(sv, task, name);
+    if (old >= 0) i0_sv_fd_drop(sv, (size_t)old);
+
+    size_t count = 0;
+    for (size_t i = 0; i < sv->fd_count; i++) {
+        if (str_eq(sv->fds[i].task, task)) count++;
+    }
+    if (count == I0_FDSTORE_MAX) return -1;
+
+    if (sv->fd_count == sv->fd_cap) {
+        sv->fd_cap = sv->fd_cap ? sv->fd_cap * 2 : 16;
+        sv->fds = realloc(sv->fds, sv->fd_cap * sizeof(*sv->fds));
+        if (!sv->fds) i0_perror("realloc()");
+    }
+
+    i0_stored_fd* stored = &sv->fds[sv->fd_count];
+    stored->task = strdup(task);
+    stored->name = strdup(name);
+    stored->fd = fd;
+    if (!stored->task || !stored->name) i0_perror("strdup()");
+    sv->fd_count++;
+    return 0;
+}
+
+// stored fds only go to the task itself or to a child of the i0 holding its
+// lock, which is about to exec a script or main. joining a task's cgroup
+// takes root, so that counts as well
+static int i0_sv_fd_peer_ok(const char* task, const pid_t peer) {
+    char found[256];
+    if (proc_task_from_cgroup(peer, found, sizeof(found)) == 0) return str_eq(found, task);
+
+    i0_string path;
+    i0_get_task_pid_file(path, task);
+    if (read_pid(path) == peer) return 1;
+
+    i0_get_task_runtime_file(path, task, "lock");
+    const pid_t owner = read_pid(path);
+    if (owner <= 0 || proc_ppid(peer) != owner) return 0;
+
+    // a stale pid in an unlocked file says nothing
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return 0;
+    const int held = flock(fd, LOCK_SH | LOCK_NB) != 0 && errno == EWOULDBLOCK;
+    close(fd);
+    return held;
+}
+
+static void i0_sv_fd_fetch(i0_sv* sv, const int sock, const char* task, const pid_t peer) {
+    if (!i0_name_ok(task) || !i0_sv_fd_peer_ok(task, peer)) {
+        i0_send_fds(sock, "", NULL, 0);
+        return;
+    }
+
+    char names[I0_FDSTORE_MAX * 65 + 1] = "";
+    int fds[I0_FDSTORE_MAX];
+    size_t n = 0, len = 0;
+
+    for (size_t i = 0; i < sv->fd_count && n < I0_FDSTORE_MAX; i++) {
+        if (!str_eq(sv->fds[i].task, task)) continue;
+        len += (size_t)snprintf(names + len, sizeof(names) - len, n ? ":%s" : "%s", sv->fds[i].name);
+        fds[n++] = sv->fds[i].fd;
+    }
+    i0_send_fds(sock, names, fds, n);
+}
+
+// `i0 reexec` swaps the supervisor's binary under its feet. what only lives
+// in its memory is written to a memfd as text, every fd mentioned there is
+// kept open across exec and the new binary picks it all up again with
+// `supervise --resume <fd> <client>`. the pid stays the same, so children
+// and the pid file never notice
+
+#define I0_STATE_MAGIC "i0-state 1\n"
+
+static void i0_sv_keep_fds(i0_sv* sv, const int client, const int keep) {
+    const int flags = keep ? 0 : FD_CLOEXEC;
+    if (sv->ctl >= 0) fcntl(sv->ctl, F_SETFD, flags);
+    if (client >= 0) fcntl(client, F_SETFD, flags);
+    for (size_t i = 0; i < sv->fd_count; i++) fcntl(sv->fds[i].fd, F_SETFD, flags);
+    for (size_t i = 0; i < sv->job_count; i++) {
+        const int fds[3] = { sv->jobs[i].client, sv->jobs[i].out, sv->jobs[i].err };
+        for (size_t j = 0; j < 3; j++) {
+            if (fds[j] >= 0) fcntl(fds[j], F_SETFD, flags);
+        }
+    }
+}
+
+// only returns if the new binary could not be started
+static void i0_sv_reexec(i0_sv* sv, const int client) {
+    i0_string exe;
+    const ssize_t len = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+    if (len <= 0) return;
+    exe[len] = '\0';
+
+    // the old binary was replaced, its path is where the new one is
+    char* deleted = strstr(exe, " (deleted)");
+    if (deleted && deleted[conststrlen(" (deleted)")] == '\0') *deleted = '\0';
+
+    const int mem = memfd_create("i0-state", 0);
+    FILE* f = mem >= 0 ? fdopen(dup(mem), "w") : NULL;
+    if (!f) {
+        i0_log(I0_LOG_BAD, i0_lang[I0_LANG_REEXEC_FAILED], exe, strerror(errno));
+        if (mem >= 0) close(mem);
+        return;
+    }
+
+    fputs(I0_STATE_MAGIC, f);
+    fprintf(f, "ctl\t%d\ncalm\t%lld\n", sv->ctl, (long long)sv->calm_at);
+    for (size_t i = 0; i < sv->fd_count; i++) {
+        fprintf(f, "fd\t%d\t%s\t%s\n", sv->fds[i].fd, sv->fds[i].task, sv->fds[i].name);
+    }
+    for (size_t i = 0; i < sv->shed_count; i++) {
+        if (!i0_state_ok(sv->shed[i].task)) continue;
+        fprintf(f, "shed\t%d\t%s\n", sv->shed[i].frozen, sv->shed[i].task);
+    }
+    for (size_t i = 0; i < sv->trigger_count; i++) {
+        const i0_trigger* t = &sv->triggers[i];
+        if (!t->path || !i0_state_ok(t->task) || !i0_state_ok(t->path)) continue;
+        fprintf(f, "trigger\t%lld\t%s\t%s\n", (long long)t->due, t->task, t->path);
+    }
+    for (size_t i = 0; i < sv->job_count; i++) {
+        const i0_sv_job* job = &sv->jobs[i];
+        if (!i0_state_ok(job->task) || (job->trigger && !i0_state_ok(job->trigger))) continue;
+        fprintf(f, "job\t%d\t%d\t%d\t%d\t%s\t%s\t%s\t%s\n", job->pid, job->client, job->out, job->err,
+                job->log[0] ? job->log : "-", i0_task_action_name(job->action), job->task,
+                job->trigger ? job->trigger : "");
+    }
+    for (size_t i = 0; i < sv->idle_count; i++) {
+        const i0_idle* e = &sv->idle[i];
+        if (!i0_state_ok(e->task)) continue;
+        fprintf(f, "idle\t%lld\t%lld\t%d\t%s\n", (long long)e->active_at, e->cpu_usec, e->pid, e->task);
+    }
+    fclose(f);
+    lseek(mem, 0, SEEK_SET);
+
+    char fd_buf[16];
+    char client_buf[16];
+    snprintf(fd_buf, sizeof(fd_buf), "%d", mem);
+    snprintf(client_buf, sizeof(client_buf), "%d", client);
+    i0_log(I0_LOG_INFO, i0_lang[I0_LANG_REEXEC_START], exe);
+    fflush(stdout);
+    fflush(stderr);
+
+    i0_sv_keep_fds(sv, client, 1);
+    execv(exe, (char* const[]){ "i0", "supervise", "--resume", fd_buf, client_buf, NULL });
+
+    i0_log(I0_LOG_BAD, i0_lang[I0_LANG_REEXEC_FAILED], exe, strerror(errno));
+    i0_sv_keep_fds(sv, client, 0);
+    close(mem);
+}
+
+// fields are tab separated, the last one takes the rest of the line
+static size_t i0_split_tabs(char* line, char** fields, const size_t max) {
+    size_t n = 0;
+    while (n < max) {
+        fields[n++] = line;
+        if (n == max || !(line = strchr(line, '\t'))) break;
+        *line++ = '\0';
+    }
+    return n;
+}
+
+// -1 if the state is unusable
+static int i0_sv_resume(i0_sv* sv, const int mem) {
+    char line[8192];
+    FILE* f = fdopen(mem, "r");
+
+    if (!f || !fgets(line, sizeof(line), f) || !str_eq(line, I0_STATE_MAGIC)) {
+        i0_log(I0_LOG_WARNING, "%s", i0_lang[I0_LANG_REEXEC_BAD_STATE]);
+        if (f) fclose(f);
+        else close(mem);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\n")] = '\0';
+        char* v[9];
+        const size_t n = i0_split_tabs(line, v, 9);
+
+        if (n == 2 && str_eq(v[0], "ctl")) {
+            sv->ctl = atoi(v[1]);
+        }
+        else if (n == 2 && str_eq(v[0], "calm")) {
+            sv->calm_at = strtoll(v[1], NULL, 10);
+        }
+        else if (n == 4 && str_eq(v[0], "fd")) {
+            const int ok = i0_name_ok(v[2]) && i0_fdstore_name_ok(v[3]);
+            if (!ok || i0_sv_fd_store(sv, v[2], v[3], atoi(v[1])) != 0) close(atoi(v[1]));
+        }
+        else if (n == 3 && str_eq(v[0], "shed") && i0_name_ok(v[2])) {
+            if (sv->shed_count == sv->shed_cap) {
+                sv->shed_cap = sv->shed_cap ? sv->shed_cap * 2 : 8;
+                sv->shed = realloc(sv->shed, sv->shed_cap * sizeof(*sv->shed));
+                if (!sv->shed) i0_perror("realloc()");
+            }
+            sv->shed[sv->shed_count] = (i0_shed_task){ .task = strdup(v[2]), .frozen = atoi(v[1]) };
+            if (!sv->shed[sv->shed_count++].task) i0_perror("strdup()");
+        }
+        else if (n == 4 && str_eq(v[0], "trigger") && i0_name_ok(v[2])) {
+            // i0_sv_watch_setup() carries these over to the new watch table.
+            // pidfds do not survive exec, so waiting ones get another look
+            i0_trigger* t = i0_sv_trigger_new(sv);
+            *t = (i0_trigger){
+                .task = strdup(v[2]),
+                .path = strdup(v[3]),
+                .due = strtoll(v[1], NULL, 10),
+                .pidfd = -1
+            };
+            if (!t->task || !t->path) i0_perror("strdup()");
+            if (!t->due) t->due = i0_clock_ns(CLOCK_MONOTONIC);
+            t->since = t->due;
+        }
+        else if (n == 9 && str_eq(v[0], "job") && i0_name_ok(v[7]) && i0_task_action_find(v[6])
+                 && strlen(v[5]) < I0_LOG_NAME_MAX) {
+            // workers are children of ours whatever binary we run
+            i0_sv_job* job = i0_sv_spawn(sv, v[7], i0_task_action_find(v[6]), v[8][0] ? v[8] : NULL);
+            job->pid = atoi(v[1]);
+            job->client = atoi(v[2]);
+            job->out = atoi(v[3]);
+            job->err = atoi(v[4]);
+            if (!str_eq(v[5], "-")) strcpy(job->log, v[5]);
+        }
+        else if (n == 5 && str_eq(v[0], "idle") && i0_name_ok(v[4])) {
+            // same for i0_sv_idle_setup(). sampling starts over, the
+            // monotonic clock goes on across exec
+            i0_idle* e = i0_sv_idle_new(sv);
+            *e = (i0_idle){
+                .task = strdup(v[4]),
+                .active_at = strtoll(v[1], NULL, 10),
+                .cpu_usec = strtoll(v[2], NULL, 10),
+                .sampled_at = i0_clock_ns(CLOCK_MONOTONIC),
+                .pid = atoi(v[3])
+            };
+            if (!e->task) i0_perror("strdup()");
+        }
+    }
+    fclose(f);
+
+    i0_sv_keep_fds(sv, -1, 0);
+    return 0;
+}
+
+static void i0_sv_ctl_drop(i0_sv* sv, const size_t i) {
+    close(sv->clients[i].fd);
+    sv->clients[i] = sv->clients[--sv->client_count];
+}
+
+// one request per connection. only our own user (or root) gets to talk to
+// us, and a store always goes to the task the sender belongs to. clients
+// are only accepted here, their requests are read once the poll loop sees
+// them, so a slow one never holds up the others
+static void i0_sv_ctl_accept(i0_sv* sv) {
+    int sock;
+    while ((sock = accept4(sv->ctl, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+        struct ucred cred;
+        socklen_t cred_len = sizeof(cred);
+        if (sv->client_count == I0_CTL_CLIENTS
+            || getsockopt(sock, SOL_SOCKET, SO_PEERCRED, &cred, &cred_len) != 0
+            || (cred.uid != 0 && cred.uid != geteuid())) {
+            close(sock);
+            continue;
+        }
+        const int64_t deadline = i0_clock_ns(CLOCK_MONOTONIC) + (int64_t)I0_CTL_TIMEOUT * 1000000;
+        sv->clients[sv->client_count++] = (i0_ctl_client){ .fd = sock, .deadline = deadline };
+    }
+}
+
+// clients that hung up or never said anything
+static void i0_sv_ctl_expire(i0_sv* sv) {
+    const int64_t now = i0_clock_ns(CLOCK_MONOTONIC);
+    for (size_t i = sv->client_count; i-- > 0;) {
+        if (sv->clients[i].deadline <= now) i0_sv_ctl_drop(sv, i);
+    }
+}
+
+// see the watch and idle sections
+static void i0_sv_watch_setup(i0_sv* sv);
+static void i0_sv_idle_setup(i0_sv* sv);
+
+// "<start|restart|handover> <I0_LOG> <task>" with the caller's stdout and
+// stderr. the client stays with the job, it hears "queued <group>" while
+// the group is full and "exit <status>" of the worker at the end
+static int i0_sv_ctl_job(i0_sv* sv, const size_t i, char* req, const int* fds, const size_t n) {
+    char* log = strchr(req, ' ');
+    char* task = log ? strchr(log + 1, ' ') : NULL;
+    if (!task || n != 2) return -1;
+    *log++ = '\0';
+    *task++ = '\0';
+
+    const i0_task_action action = i0_task_action_find(req);
+    if (!action || action == i0_task_stop_script || strlen(log) >= I0_LOG_NAME_MAX) return -1;
+
+    i0_string path;
+    i0_sv_task_path(sv, task, "", path);
+    if (!i0_name_ok(task) || !i0_state_ok(task) || !dir_exists(path)) return -1;
+
+    i0_sv_job* job = i0_sv_spawn(sv, task, action, NULL);
+    job->client = sv->clients[i].fd;
+    job->out = fds[0];
+    job->err = fds[1];
+    strcpy(job->log, log);
+    sv->clients[i] = sv->clients[--sv->client_count];
+    i0_sv_run_jobs(sv);
+    return 0;
+}
+
+// answers the request of client i and lets it go
+static void i0_sv_ctl_request(i0_sv* sv, const size_t i) {
+    const int sock = sv->clients[i].fd;
+    struct ucred cred;
+    socklen_t cred_len = sizeof(cred);
+    char req[300];
+    int fds[I0_FDSTORE_MAX];
+    size_t n = 0;
+
+    const ssize_t len = i0_recv_fds(sock, req, sizeof(req), fds, &n);
+    if (len < 0 && (errno == EAGAIN || errno == EINTR)) return;
+    if (len <= 0 || getsockopt(sock, SOL_SOCKET, SO_PEERCRED, &cred, &cred_len) != 0) {
+        for (size_t j = 0; j < n; j++) close(fds[j]);
+        i0_sv_ctl_drop(sv, i);
+        return;
+    }
+
+    char task[256];
+    const char* reply = "error";
+
+    if (strncmp(req, "fetch ", 6) == 0) {
+        i0_sv_fd_fetch(sv, sock, req + 6, cred.pid);
+        reply = NULL;
+    }
+    else if (strncmp(req, "store ", 6) == 0 && n == 1 && i0_fdstore_name_ok(req + 6)
+             && proc_task(cred.pid, task, sizeof(task)) == 0
+             && i0_sv_fd_store(sv, task, req + 6, fds[0]) == 0) {
+        i0_log(I0_LOG_INFO, i0_lang[I0_LANG_FDSTORE_STORED], req + 6, task);
+        n = 0;
+        reply = "ok";
+    }
+    else if (strncmp(req, "remove ", 7) == 0 && proc_task(cred.pid, task, sizeof(task)) == 0) {
+        const int i = i0_sv_fd_find(sv, task, req + 7);
+        if (i >= 0) i0_sv_fd_drop(sv, (size_t)i);
+        reply = "ok";
+    }
+    else if (str_eq(req, "reload")) {
+        // `i0 new` and `i0 import` may have added watch or idle.timeout files
+        i0_sv_watch_setup(sv);
+        i0_sv_idle_setup(sv);
+        reply = "ok";
+    }
+    else if (str_eq(req, "reexec")) {
+        // the new binary answers if it comes up
+        i0_sv_reexec(sv, sock);
+    }
+    else if (i0_sv_ctl_job(sv, i, req, fds, n) == 0) {
+        return;
     }
 
-    if (description[0] != '\0') {
-        const size_t len = strlen(description);
-        description[len] = '\n'; // posix standard thing idk
-        i0_string_append(task_path, task_path_size, "/description", conststrlen("/description") + 1);
-        open_write(task_path, description, len + 1);
+    for (size_t j = 0; j < n; j++) close(fds[j]);
+    if (reply) i0_send_fds(sock, reply, NULL, 0);
+    i0_sv_ctl_drop(sv, i);
+}
+
+static uint32_t i0_watch_mask(const char* task, char* events) {
+    static const struct { const char* name; uint32_t mask; } names[] = {
+        { "create", IN_CREATE },
+        { "write", IN_CLOSE_WRITE },
+        { "move", IN_MOVED_TO },
+        { "modify", IN_MODIFY },
+        { "delete", IN_DELETE | IN_MOVED_FROM },
+        { "attrib", IN_ATTRIB },
+    };
+
+    uint32_t mask = 0;
+    for (char* ev = strtok(events, ","); ev; ev = strtok(NULL, ",")) {
+        size_t i = 0;
+        while (i < sizeof(names) / sizeof(*names) && !str_eq(names[i].name, ev)) i++;
+
+        if (i == sizeof(names) / sizeof(*names)) {
+            i0_log(I0_LOG_WARNING, i0_lang[I0_LANG_WATCH_BAD_EVENT], task, ev);
+        }
+        else {
+            mask |= names[i].mask;
+        }
     }
+    return mask ? mask : I0_WATCH_EVENTS;
+}
 
-    if (autostart) {
-        i0_string_append(task_path, task_path_size, "/enabled", conststrlen("/enabled") + 1);
-        FILE* f = safe_fopen(task_path, "w");
-        fclose(f);
+static void i0_sv_watch_add(i0_sv* sv, const size_t trigger, const char* path, const uint32_t mask) {
+    const int wd = inotify_add_watch(sv->ino, path, mask | IN_MASK_ADD);
+    if (wd < 0) {
+        i0_log(I0_LOG_WARNING, i0_lang[I0_LANG_WATCH_FAILED], sv->triggers[trigger].task, path, strerror(errno));
+        return;
     }
 
-    task_path[task_path_size] = '\0';
-    i0_log(I0_LOG_GOOD, i0_lang[I0_LANG_NEW_TASK_CREATED], task_path);
-    exit(EXIT_SUCCESS);
+    if (sv->watch_count == sv->watch_cap) {
+        sv->watch_cap = sv->watch_cap ? sv->watch_cap * 2 : 16;
+        sv->watches = realloc(sv->watches, sv->watch_cap * sizeof(*sv->watches));
+        if (!sv->watches) i0_perror("realloc()");
+    }
+    sv->watches[sv->watch_count++] = (i0_watch){ .wd = wd, .mask = mask, .path = strdup(path), .trigger = trigger };
 }
 
-static void i0_task_start(const char* task) {
-    FILE* f = fopen("./pid", "r");
-    if (f) {
-        pid_t pid;
-        if (fscanf(f, "%d", &pid) == 1 && is_process_alive(pid)) {
-            char pidbuf[16];
-            snprintf(pidbuf, 16, "%d", pid);
-            i0_log(I0_LOG_WARNING, i0_lang[I0_LANG_STATUS_ALREADY_RUNNING], pidbuf);
-            fclose(f);
-            return;
+static void i0_sv_watch_task(i0_sv* sv, const char* task) {
+    i0_string path;
+    i0_sv_task_path(sv, task, "/watch", path);
+    FILE* f = fopen(path, "r");
+    if (!f) return;
+
+    i0_trigger* t = i0_sv_trigger_new(sv);
+    const size_t trigger = (size_t)(t - sv->triggers);
+    *t = (i0_trigger){ .task = strdup(task), .pidfd = -1 };
+    if (!t->task) i0_perror("strdup()");
+    i0_sv_task_path(sv, task, "/watch.delay", path);
+    t->delay_ms = read_long(path, I0_WATCH_DELAY_MS);
+
+    char line[4096 + 256];
+    while (fgets(line, sizeof(line), f)) {
+        char* watched = strtok(line, " \t\n");
+        if (!watched || watched[0] == '#') continue;
+
+        char* events = strtok(NULL, " \t\n");
+        char none[] = "";
+        i0_sv_watch_add(sv, trigger, watched, i0_watch_mask(task, events ? events : none));
+    }
+    fclose(f);
+}
+
+// (re)reads every watch file. pending triggers and running starts of tasks
+// that still watch something are carried over
+static void i0_sv_watch_setup(i0_sv* sv) {
+    i0_trigger* old = sv->triggers;
+    const size_t old_count = sv->trigger_count;
+
+    if (sv->ino >= 0) close(sv->ino);
+    for (size_t i = 0; i < sv->watch_count; i++) free(sv->watches[i].path);
+    free(sv->watches);
+    sv->watches = NULL;
+    sv->watch_count = 0;
+    sv->watch_cap = 0;
+    sv->triggers = NULL;
+    sv->trigger_count = 0;
+    sv->trigger_cap = 0;
+
+    sv->ino = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    DIR* d = sv->ino >= 0 ? opendir(sv->dir) : NULL;
+    if (d) {
+        struct dirent* dir;
+        while ((dir = readdir(d)) != NULL) {
+            if (dir->d_name[0] != '.') i0_sv_watch_task(sv, dir->d_name);
         }
-        fclose(f);
+        closedir(d);
     }
 
-    pid_t pid;
-    fork_and_do(pid, safe_execlp("./main", "./main", NULL), open_write_int("./pid", pid));
+    for (size_t i = 0; i < old_count; i++) {
+        for (size_t j = 0; j < sv->trigger_count; j++) {
+            if (!str_eq(old[i].task, sv->triggers[j].task)) continue;
+            sv->triggers[j].path = old[i].path;
+            sv->triggers[j].due = old[i].due;
+            sv->triggers[j].since = old[i].since;
+            sv->triggers[j].pidfd = old[i].pidfd;
+            old[i].path = NULL;
+            old[i].pidfd = -1;
+        }
+        if (old[i].pidfd >= 0) close(old[i].pidfd);
+        free(old[i].task);
+        free(old[i].path);
+    }
+    free(old);
 
-    i0_log(I0_LOG_TASK_START, i0_lang[I0_LANG_STATUS_STARTED], task);
+    if (sv->ino >= 0 && sv->watch_count == 0) {
+        close(sv->ino);
+        sv->ino = -1;
+    }
 }
 
-static void i0_task_start_script(const char* task, const char* path) {
-    if (chdir(path) != 0) {
-        i0_perror("chdir");
+static void i0_trigger_set(i0_trigger* t, const char* path, const size_t name_len, const char* name) {
+    const int64_t now = i0_clock_ns(CLOCK_MONOTONIC);
+    if (!t->path) t->since = now;
+    free(t->path);
+    t->path = malloc(strlen(path) + name_len + 2);
+    if (!t->path) i0_perror("malloc()");
+
+    strcpy(t->path, path);
+    if (name_len) {
+        strcat(t->path, "/");
+        strcat(t->path, name);
     }
+    // waiting for the task to exit is not up to the delay
+    if (t->path && !t->due && t->pidfd >= 0) return;
 
-    if (file_exists("./start")) {
-        i0_run_wait("./start");
-        return;
+    const long max_ms = t->delay_ms > I0_WATCH_MAX_DELAY_MS ? t->delay_ms : I0_WATCH_MAX_DELAY_MS;
+    t->due = now + (int64_t)t->delay_ms * 1000000;
+    if (t->due > t->since + (int64_t)max_ms * 1000000) t->due = t->since + (int64_t)max_ms * 1000000;
+}
+
+static void i0_sv_watch_read(i0_sv* sv) {
+    union {
+        char buf[4096];
+        struct inotify_event align;
+    } u;
+
+    ssize_t n;
+    while ((n = read(sv->ino, u.buf, sizeof(u.buf))) > 0) {
+        for (char* p = u.buf; p < u.buf + n; p += sizeof(struct inotify_event) + ((struct inotify_event*)p)->len) {
+            const struct inotify_event* ev = (const struct inotify_event*)p;
+
+            // events got lost, so whatever watches anything runs once
+            if (ev->mask & IN_Q_OVERFLOW) {
+                for (size_t i = 0; i < sv->watch_count; i++) {
+                    i0_trigger_set(&sv->triggers[sv->watches[i].trigger], sv->watches[i].path, 0, NULL);
+                }
+                continue;
+            }
+
+            for (size_t i = 0; i < sv->watch_count; i++) {
+                const i0_watch* w = &sv->watches[i];
+                if (w->wd != ev->wd || !(w->mask & ev->mask)) continue;
+                i0_trigger_set(&sv->triggers[w->trigger], w->path, ev->len ? strlen(ev->name) : 0, ev->name);
+            }
+        }
     }
+}
 
-    if (file_exists("./main")) {
-        i0_task_start(task);
-        return;
+// whether the task still runs. a job of ours is reaped through SIGCHLD,
+// anything else is waited for on a pidfd
+static int i0_trigger_busy(i0_sv* sv, i0_trigger* t, const int64_t now) {
+    if (i0_sv_job_find(sv, t->task)) {
+        t->due = 0;
+        return 1;
     }
 
-    i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_ERROR_MAIN_NOT_FOUND]);
+    i0_string path;
+    i0_get_task_pid_file(path, t->task);
+    const pid_t pid = read_pid(path);
+    if (pid <= 0 || !is_process_alive(pid) || proc_zombie(pid)) return 0;
+
+    if (t->pidfd < 0 && (t->pidfd = i0_pidfd_open(pid)) < 0) {
+        if (errno == ESRCH) return 0;
+        // kernels without pidfd, look again later
+        t->due = now + (int64_t)I0_WATCH_DELAY_MS * 1000000;
+        return 1;
+    }
+    t->due = 0;
+    return 1;
 }
 
-static void i0_task_stop(const char* task) {
-    FILE* f = fopen("./pid", "r");
-    if (!f) {
-        i0_log(I0_LOG_WARNING, "%s", i0_lang[I0_LANG_STATUS_ALREADY_STOPPED]);
-        return;
+// a task someone else started exited
+static void i0_sv_trigger_exited(i0_sv* sv, const size_t i) {
+    i0_trigger* t = &sv->triggers[i];
+    close(t->pidfd);
+    t->pidfd = -1;
+    if (t->path && !t->due) t->due = i0_clock_ns(CLOCK_MONOTONIC);
+}
+
+static void i0_sv_watch_fire(i0_sv* sv) {
+    const int64_t now = i0_clock_ns(CLOCK_MONOTONIC);
+
+    for (size_t i = 0; i < sv->trigger_count; i++) {
+        i0_trigger* t = &sv->triggers[i];
+        if (!t->path || !t->due || t->due > now) continue;
+        if (i0_trigger_busy(sv, t, now)) continue;
+
+        i0_log(I0_LOG_INFO, i0_lang[I0_LANG_WATCH_TRIGGERED], t->task, t->path);
+        i0_sv_spawn(sv, t->task, i0_task_start_script, t->path);
+        free(t->path);
+        t->path = NULL;
+        t->due = 0;
     }
+    i0_sv_run_jobs(sv);
+}
 
-    pid_t pid;
-    if (fscanf(f, "%d", &pid) != 1) {
-        fclose(f);
-        i0_log(I0_LOG_WARNING, "%s", i0_lang[I0_LANG_STATUS_ALREADY_STOPPED]);
-        return;
+// (re)reads every idle.timeout file, what was seen of tasks that still
+// have one is carried over
+static void i0_sv_idle_setup(i0_sv* sv) {
+    i0_idle* old = sv->idle;
+    const size_t old_count = sv->idle_count;
+    sv->idle = NULL;
+    sv->idle_count = 0;
+    sv->idle_cap = 0;
+
+    DIR* d = opendir(sv->dir);
+    struct dirent* dir;
+    while (d && (dir = readdir(d)) != NULL) {
+        if (dir->d_name[0] == '.') continue;
+
+        i0_string path;
+        i0_sv_task_path(sv, dir->d_name, "/idle.timeout", path);
+        const long timeout = read_long(path, 0);
+        if (timeout <= 0) continue;
+
+        i0_idle* e = i0_sv_idle_new(sv);
+        *e = (i0_idle){ .task = strdup(dir->d_name), .timeout = timeout };
+        if (!e->task) i0_perror("strdup()");
     }
-    fclose(f);
+    if (d) closedir(d);
+
+    for (size_t i = 0; i < old_count; i++) {
+        for (size_t j = 0; j < sv->idle_count; j++) {
+            if (!str_eq(old[i].task, sv->idle[j].task)) continue;
+            sv->idle[j].pid = old[i].pid;
+            sv->idle[j].cpu_usec = old[i].cpu_usec;
+            sv->idle[j].sampled_at = old[i].sampled_at;
+            sv->idle[j].active_at = old[i].active_at;
+        }
+        free(old[i].task);
+    }
+    free(old);
+    sv->idle_check_at = sv->idle_count ? i0_clock_ns(CLOCK_MONOTONIC) : 0;
+}
 
-    if (!is_process_alive(pid)) {
-        unlink("./pid");
-        i0_log(I0_LOG_WARNING, "%s", i0_lang[I0_LANG_STATUS_ALREADY_STOPPED]);
-        return;
+// cpu time a task has used so far in microseconds, -1 if unknown
+static long long i0_task_cpu_usec(const char* task, const pid_t pid) {
+    i0_string path;
+    char line[512];
+    long long usec = -1;
+
+    FILE* f = i0_cgroup_path(task, "cpu.stat", path) == 0 ? fopen(path, "r") : NULL;
+    while (f && usec < 0 && fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "usage_usec %lld", &usec) != 1) usec = -1;
     }
+    if (f) fclose(f);
+    if (usec >= 0) return usec;
 
-    if (kill(pid, SIGKILL) != 0) {
-        if (errno == ESRCH) {
-            unlink("pid");
-            i0_log(I0_LOG_WARNING, "%s", i0_lang[I0_LANG_STATUS_ALREADY_STOPPED]);
+    // without a cgroup, every process of the task: a prefork master may
+    // sleep while its workers do the work
+    DIR* d = opendir("/proc");
+    if (!d) return -1;
+
+    unsigned long long ticks = 0;
+    int found = 0;
+    struct dirent* dir;
+    while ((dir = readdir(d)) != NULL) {
+        char* end;
+        const pid_t other = (pid_t)strtol(dir->d_name, &end, 10);
+        if (*end != '\0' || other <= 0) continue;
+
+        char owner[256];
+        if (other != pid && (proc_task(other, owner, sizeof(owner)) != 0 || !str_eq(owner, task))) continue;
+
+        // utime, stime and the same for children that were waited for
+        snprintf(path, sizeof(path), "/proc/%d/stat", other);
+        if (!(f = fopen(path, "r"))) continue;
+        const size_t n = fread(line, 1, sizeof(line) - 1, f);
+        fclose(f);
+        line[n] = '\0';
+
+        const char* p = strrchr(line, ')');
+        unsigned long long utime, stime, cutime, cstime;
+        if (!p || sscanf(p + 1, " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu %llu %llu",
+                         &utime, &stime, &cutime, &cstime) != 4) {
+            continue;
+        }
+        ticks += utime + stime + cutime + cstime;
+        found = 1;
+    }
+    closedir(d);
+    return found ? (long long)(ticks * 1000000 / (unsigned long long)sysconf(_SC_CLK_TCK)) : -1;
+}
+
+// a task is only sampled when its timeout would run out, so it is stopped
+// once a whole timeout went by below I0_IDLE_CPU_PERMILLE. tasks that are
+// not running are looked at again one timeout later
+static void i0_sv_idle_check(i0_sv* sv) {
+    const int64_t now = i0_clock_ns(CLOCK_MONOTONIC);
+    if (!sv->idle_check_at || now < sv->idle_check_at) return;
+
+    int64_t next = 0;
+    for (size_t i = 0; i < sv->idle_count; i++) {
+        i0_idle* e = &sv->idle[i];
+        const int64_t timeout = (int64_t)e->timeout * 1000000000;
+        int64_t at = now + timeout;
+
+        i0_string path;
+        i0_get_task_pid_file(path, e->task);
+        const pid_t pid = read_pid(path);
+        if (pid <= 0 || !is_process_alive(pid) || i0_sv_is_shed(sv, e->task)) {
+            e->pid = 0;
+        }
+        else if (now < e->active_at + timeout && pid == e->pid) {
+            at = e->active_at + timeout;
         }
         else {
-            i0_perror("kill()");
+            // a new instance counts as activity, and so does cpu time we
+            // cannot read or that went down: a process of the task exited
+            // and took its share with it
+            const long long cpu = i0_task_cpu_usec(e->task, pid);
+            const long long used = cpu - e->cpu_usec;
+            const long long wall = (now - e->sampled_at) / 1000;
+            const int active = pid != e->pid || cpu < 0 || e->cpu_usec < 0 || used < 0
+                || used * 1000 > wall * I0_IDLE_CPU_PERMILLE;
+            e->pid = pid;
+            e->cpu_usec = cpu;
+            e->sampled_at = now;
+
+            if (active) {
+                e->active_at = now;
+            }
+            else {
+                i0_log(I0_LOG_INFO, i0_lang[I0_LANG_IDLE_STOP], e->task, e->timeout);
+                i0_sv_spawn(sv, e->task, i0_task_stop_script, NULL);
+                i0_sv_run_jobs(sv);
+                e->active_at = now;
+            }
         }
-        return;
+        if (!next || at < next) next = at;
     }
-
-    unlink("./pid");
-    i0_log(I0_LOG_TASK_STOP, i0_lang[I0_LANG_STATUS_STOPPED], task);
+    sv->idle_check_at = next;
 }
 
-static void i0_task_stop_script(const char* task, const char* path) {
-    if (chdir(path) != 0) {
-        i0_perror("chdir");
+static int i0_sv_timeout(i0_sv* sv) {
+    int64_t at = sv->calm_at;
+    if (sv->idle_check_at && (!at || sv->idle_check_at < at)) at = sv->idle_check_at;
+    for (size_t i = 0; i < sv->client_count; i++) {
+        if (!at || sv->clients[i].deadline < at) at = sv->clients[i].deadline;
     }
-
-    if (file_exists("./stop")) {
-        i0_run_wait("./stop");
-        return;
+    for (size_t i = 0; i < sv->trigger_count; i++) {
+        const int64_t due = sv->triggers[i].path ? sv->triggers[i].due : 0;
+        if (due && (!at || due < at)) at = due;
     }
+    if (!at) return -1;
 
-    i0_task_stop(task);
+    const int64_t left = at - i0_clock_ns(CLOCK_MONOTONIC);
+    return left > 0 ? (int)(left / 1000000) + 1 : 0;
 }
 
-static void i0_task_status() {
-    if (file_exists("./enabled")) i0_log(I0_LOG_GOOD, "%s", i0_lang[I0_LANG_STATUS_ENABLED]);
+static void i0_sv_signals(i0_sv* sv) {
+    struct signalfd_siginfo si;
+    while (read(sv->sigfd, &si, sizeof(si)) == (ssize_t)sizeof(si)) {
+        switch (si.ssi_signo) {
+        case SIGCHLD:
+            i0_sv_reap(sv);
+            break;
+        case SIGTERM:
+        case SIGINT:
+            // init has nowhere to go
+            if (getpid() == 1) break;
+            struct sockaddr_un addr;
+            if (sv->ctl >= 0 && i0_fdstore_addr(&addr) == 0) unlink(addr.sun_path);
+            i0_string pid_file;
+            i0_get_runtime_dir(pid_file);
+            i0_string_append(pid_file, strlen(pid_file), I0_SUPERVISOR_PID, conststrlen(I0_SUPERVISOR_PID) + 1);
+            unlink(pid_file);
+            i0_log(I0_LOG_INFO, "%s", i0_lang[I0_LANG_SUPERVISE_END]);
+            exit(EXIT_SUCCESS);
+        case SIGHUP:
+            i0_sv_watch_setup(sv);
+            i0_sv_idle_setup(sv);
+            break;
+        default:
+            break;
+        }
+    }
+}
 
-    FILE* f = fopen("./description", "r");
-    if (f) {
-        char buffer[512] = {0};
+_Noreturn static void i0_supervise(const int resume, int client) {
+    static i0_sv sv;
 
-        // posix standard suggests each file to have \n in the end
-        // and that completely fucks up i0_log output
-        fread(buffer, 1, sizeof(buffer) - 1, f);
+    if (prctl(PR_SET_CHILD_SUBREAPER, 1) != 0) {
+        i0_perror("prctl()");
+    }
 
-        const size_t desc_len = strlen(buffer);
-        if (desc_len > 0 && buffer[desc_len - 1] == '\n') {
-            buffer[desc_len - 1] = '\0';
-        }
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGCHLD);
+    sigaddset(&set, SIGTERM);
+    sigaddset(&set, SIGINT);
+    sigaddset(&set, SIGHUP);
+    if (sigprocmask(SIG_BLOCK, &set, NULL) != 0) {
+        i0_perror("sigprocmask()");
+    }
 
-        i0_log(I0_LOG_INFO, "%s: %s", i0_lang[I0_LANG_STATUS_DESCRIPTION], buffer);
+    sv.sigfd = signalfd(-1, &set, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (sv.sigfd < 0) {
+        i0_perror("signalfd()");
+    }
 
-        fclose(f);
+    i0_get_tasks_dir(sv.dir);
+    sv.ctl = -1;
+
+    if (resume >= 0) {
+        if (client >= 0) fcntl(client, F_SETFD, FD_CLOEXEC);
+        if (i0_sv_resume(&sv, resume) != 0 && client >= 0) {
+            // up, but with nothing of what the old binary had
+            i0_send_fds(client, "error", NULL, 0);
+            close(client);
+            client = -1;
+        }
+        i0_log(I0_LOG_INFO, i0_lang[I0_LANG_REEXEC_RESUMED], I0_VERSION_FULL);
+    }
+    else {
+        i0_log(I0_LOG_INFO, "%s", i0_lang[I0_LANG_SUPERVISE_START]);
     }
 
-    f = fopen("./pid", "r");
-    if (f) {
-        pid_t pid;
-        if (fscanf(f, "%d", &pid) == 1 && is_process_alive(pid)) {
-            char pidbuf[16];
-            snprintf(pidbuf, 16, "%d", pid);
-            i0_log(I0_LOG_GOOD, i0_lang[I0_LANG_STATUS_RUNNING], pidbuf);
+    i0_sv_psi_setup(&sv);
+    if (sv.ctl < 0) i0_sv_ctl_setup(&sv);
+    sv.ino = -1;
+    i0_sv_pid_setup();
+    i0_sv_watch_setup(&sv);
+    i0_sv_idle_setup(&sv);
+    i0_sv_events_setup(&sv);
+
+    // a failing start script only takes its worker down, not us
+    if (resume < 0) i0_sv_boot(&sv);
+    else i0_sv_run_jobs(&sv);
+
+    if (client >= 0) {
+        i0_send_fds(client, "ok", NULL, 0);
+        close(client);
+    }
 
-            struct stat st;
+    struct pollfd* pfd = NULL;
+    size_t pfd_cap = 0;
 
-            if (stat("./pid", &st) != 0) {
-                i0_perror("stat()");
-            }
+    for (;;) {
+        // fixed fds, control clients, then the pidfds of the triggers
+        const size_t clients = sv.client_count;
+        const size_t triggers = sv.trigger_count;
+        const size_t count = 6 + clients + triggers;
+        if (count > pfd_cap) {
+            while (pfd_cap < count) pfd_cap = pfd_cap ? pfd_cap * 2 : 32;
+            pfd = realloc(pfd, pfd_cap * sizeof(*pfd));
+            if (!pfd) i0_perror("realloc()");
+        }
 
-            struct tm* tm = localtime(&st.st_mtime);
-            if (!tm) {
-                i0_perror("localtime()");
-            }
+        pfd[0] = (struct pollfd){ .fd = sv.sigfd, .events = POLLIN };
+        pfd[1] = (struct pollfd){ .fd = sv.psi[0], .events = POLLPRI };
+        pfd[2] = (struct pollfd){ .fd = sv.psi[1], .events = POLLPRI };
+        pfd[3] = (struct pollfd){ .fd = sv.ctl, .events = POLLIN };
+        pfd[4] = (struct pollfd){ .fd = sv.ino, .events = POLLIN };
+        pfd[5] = (struct pollfd){ .fd = sv.events, .events = POLLIN };
+        for (size_t i = 0; i < clients; i++) {
+            pfd[6 + i] = (struct pollfd){ .fd = sv.clients[i].fd, .events = POLLIN };
+        }
+        for (size_t i = 0; i < triggers; i++) {
+            pfd[6 + clients + i] = (struct pollfd){ .fd = sv.triggers[i].pidfd, .events = POLLIN };
+        }
+        if (poll(pfd, count, i0_sv_timeout(&sv)) < 0) {
+            if (errno == EINTR) continue;
+            i0_perror("poll()");
+        }
 
-            char time_buf[64];
-            if (!strftime(time_buf, sizeof(time_buf), "%Y-%m-%d %H:%M:%S", tm)) {
-                i0_perror("strftime()");
+        // before SIGHUP gets to rebuild the trigger table
+        for (size_t i = 0; i < triggers; i++) {
+            if (pfd[6 + clients + i].revents) i0_sv_trigger_exited(&sv, i);
+        }
+
+        if (pfd[0].revents & POLLIN) i0_sv_signals(&sv);
+
+        // backwards, dropping a client moves the last one into its place
+        for (size_t i = clients; i-- > 0;) {
+            if (pfd[6 + i].revents) i0_sv_ctl_request(&sv, i);
+        }
+        i0_sv_ctl_expire(&sv);
+        if (pfd[3].revents & POLLIN) i0_sv_ctl_accept(&sv);
+
+        if (pfd[4].revents & POLLIN) i0_sv_watch_read(&sv);
+        if (pfd[5].revents & POLLIN) i0_sv_events_read(&sv);
+        i0_sv_watch_fire(&sv);
+        i0_sv_idle_check(&sv);
+
+        for (size_t i = 1; i < 3; i++) {
+            if (pfd[i].revents & POLLERR) {
+                close(sv.psi[i - 1]);
+                sv.psi[i - 1] = -1;
             }
+            else if (pfd[i].revents & POLLPRI) {
+                i0_sv_shed(&sv);
+            }
+        }
 
-            i0_log(I0_LOG_GOOD, i0_lang[I0_LANG_STATUS_STARTED_AT], time_buf);
+        if (sv.calm_at && i0_sv_timeout(&sv) == 0) {
+            if (sv.shed_count) i0_sv_unshed(&sv);
+            else sv.calm_at = 0;
         }
-        else goto not_running;
-        fclose(f);
     }
-    else goto not_running;
-    return;
-    not_running:
-        i0_log(I0_LOG_BAD, "%s", i0_lang[I0_LANG_STATUS_NOT_RUNNING]);
 }
 
-static void i0_task_status_script(const char* task, const char* path) {
-    if (chdir(path) != 0) {
-        i0_perror("chdir");
+// asks the running supervisor to exec its binary again, e.g. after an
+// upgrade. its children keep running
+static int i0_reexec() {
+    char reply[16];
+    int fds[I0_FDSTORE_MAX];
+    size_t n;
+    if (i0_fdstore_call("reexec", NULL, 0, reply, sizeof(reply), fds, &n) != 0) {
+        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_FDSTORE_NO_SUPERVISOR]);
     }
+    for (size_t i = 0; i < n; i++) close(fds[i]);
 
-    if (file_exists("./status")) {
-        i0_run_wait("./status");
+    if (!str_eq(reply, "ok")) {
+        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_REEXEC_REFUSED]);
+    }
+    i0_log(I0_LOG_GOOD, "%s", i0_lang[I0_LANG_REEXEC_DONE]);
+    return EXIT_SUCCESS;
+}
+
+// =========================================== //
+// waiting                                     //
+// =========================================== //
+
+// i0 wait [--exit|--ready] [--all|--any] [--timeout N] <task>...
+// sleeps on the tasks' pidfds and on the event journal, nothing is polled.
+// exits with the task's exit status (128 + N if it was killed by signal
+// N), with 124 on timeout, like timeout(1) does, or with 125 if nobody
+// recorded how the task ended. --ready runs the healthchecks itself and
+// fails as soon as the task exits
+
+#define I0_WAIT_TIMEOUT_STATUS 124
+#define I0_WAIT_UNKNOWN_STATUS 125
+#define I0_WAIT_EXIT_GRACE_MS 500 // for the supervisor to record the exit
+
+typedef struct i0_waiter {
+    const char* task;
+    i0_string dir;
+    i0_string pid_path;
+    pid_t pid;
+    int pidfd;
+    int exited;
+    int64_t exited_at;
+    int64_t seen_at;  // --ready: when pid was first seen running
+    int64_t check_at; // --ready: when to run the healthcheck next
+    int64_t deadline; // --timeout, 0 for none
+    int interval;
+    int done;
+    int status;
+} i0_waiter;
+
+static void i0_waiter_start(i0_waiter* w, const int ready) {
+    w->pidfd = -1;
+    if (ready) return;
+
+    w->pid = read_pid(w->pid_path);
+    if (w->pid <= 0 || !is_process_alive(w->pid)) {
+        // not running, report how it ended last time
+        w->pid = 0;
+        w->exited = 1;
         return;
     }
 
-    i0_task_status();
+    w->pidfd = i0_pidfd_open(w->pid);
+    if (w->pidfd < 0 && errno == ESRCH) w->exited = 1;
 }
 
-static void i0_boot_scan(i0_string path) {
-    // path == "/tasks/\0"
-    DIR* d = opendir(path);
-    if (!d) {
-        if (errno == ENOENT) return;
-        i0_perror("opendir()");
-    }
+// an exit recorded by the supervisor or a stop by i0 itself, whichever
+// came last
+static int i0_waiter_status(const i0_waiter* w, int* status) {
+    i0_event ev;
+    const unsigned types = I0_EVENT_BIT(I0_EVENT_EXIT) | I0_EVENT_BIT(I0_EVENT_STOP);
+    if (i0_event_find_any(w->task, types, w->pid, &ev) != 0) return -1;
+    *status = i0_event_exit_status(&ev);
+    return 0;
+}
 
-    const size_t path_len = strlen(path);
+// one healthcheck run, in the task dir like any of its scripts
+static int i0_waiter_healthy(i0_waiter* w) {
+    i0_task_enter(w->task, w->dir);
 
-    struct dirent* dir;
-    while ((dir = readdir(d)) != NULL) {
-        const char* filename = dir->d_name;
+    char pidbuf[16];
+    snprintf(pidbuf, sizeof(pidbuf), "%d", w->pid);
+    setenv("I0_PID", pidbuf, 1);
+    if (i0_run_healthcheck("./healthcheck", w->deadline) != 0) return 0;
 
-        if (str_eq(dir->d_name, ".") || str_eq(dir->d_name, "..")) {
-            continue;
-        }
+    i0_event_log(w->task, I0_EVENT_HEALTH, w->pid, 0, 0);
+    return 1;
+}
 
-        const size_t filename_len = strlen(filename);
+static void i0_waiter_check_ready(i0_waiter* w, const int64_t now) {
+    i0_event ev;
+
+    if (!w->pid) {
+        // not started yet, the journal wakes us up once it is
+        const pid_t pid = read_pid(w->pid_path);
+        if (pid <= 0 || !is_process_alive(pid)) return;
+        w->pid = pid;
+        w->pidfd = i0_pidfd_open(pid);
+        w->seen_at = w->check_at = now;
+        w->interval = 50;
+    }
 
-        i0_string_append(path, path_len, filename, filename_len + 1);
-        if (!dir_exists(path)) {
-            continue;
-        }
-        // path == "/tasks/task\0"
+    // kernels without pidfd
+    if (!w->exited && w->pidfd < 0 && !is_process_alive(w->pid)) w->exited = 1;
+    if (w->exited || i0_event_find(w->task, I0_EVENT_EXIT, w->pid, &ev) == 0) {
+        w->done = 1;
+        if (i0_waiter_status(w, &w->status) != 0 || w->status == 0) w->status = EXIT_FAILURE;
+        i0_log(I0_LOG_BAD, i0_lang[I0_LANG_WAIT_NOT_READY], w->task, w->status);
+        return;
+    }
 
-        const size_t path_filename_len = path_len + filename_len;
-        i0_string_append(path, path_filename_len, "/enabled", conststrlen("/enabled") + 1);
-        // path == "/tasks/task/enabled\0"
+    int ready = i0_event_find(w->task, I0_EVENT_READY, w->pid, &ev) == 0;
+    if (!ready && now >= w->check_at) {
+        i0_string healthcheck;
+        memcpy(healthcheck, w->dir, sizeof(healthcheck));
+        i0_string_append(healthcheck, strlen(healthcheck), "/healthcheck", conststrlen("/healthcheck") + 1);
 
-        if (file_exists(path)) {
-            i0_task_start_script(dir->d_name, path);
+        if (!file_exists(healthcheck)) {
+            // nothing to ask, so surviving the grace period has to do
+            ready = now - w->seen_at >= (int64_t)I0_READY_GRACE * 1000000;
+            w->check_at = w->seen_at + (int64_t)I0_READY_GRACE * 1000000;
+        }
+        else {
+            ready = i0_waiter_healthy(w);
+            w->check_at = now + (int64_t)w->interval * 1000000;
+            w->interval = w->interval < 1000 ? w->interval * 2 : 1000;
         }
+        if (ready) i0_event_log(w->task, I0_EVENT_READY, w->pid, 0, 0);
     }
-    closedir(d);
+    if (!ready) return;
+
+    w->done = 1;
+    i0_log(I0_LOG_GOOD, i0_lang[I0_LANG_WAIT_READY], w->task);
 }
 
-_Noreturn static void i0_boot() {
-    i0_log(I0_LOG_INFO, "%s", i0_lang[I0_LANG_BOOT_START]);
+static void i0_waiter_check(i0_waiter* w, const int ready, const int64_t now) {
+    if (w->done) return;
+    if (ready) {
+        i0_waiter_check_ready(w, now);
+        return;
+    }
 
-    i0_string path;
-    i0_get_tasks_dir(path);
-    i0_boot_scan(path);
+    // kernels without pidfd
+    if (!w->exited && w->pidfd < 0 && !is_process_alive(w->pid)) w->exited = 1;
+    if (!w->exited) return;
+    if (!w->exited_at) w->exited_at = now;
 
-    i0_log(I0_LOG_INFO, "%s", i0_lang[I0_LANG_BOOT_END]);
-    exit(EXIT_SUCCESS);
+    if (i0_waiter_status(w, &w->status) != 0) {
+        if (now - w->exited_at < (int64_t)I0_WAIT_EXIT_GRACE_MS * 1000000 && w->pid) return;
+
+        // no supervisor saw it go
+        w->done = 1;
+        w->status = I0_WAIT_UNKNOWN_STATUS;
+        i0_log(I0_LOG_WARNING, i0_lang[I0_LANG_WAIT_UNKNOWN], w->task);
+        return;
+    }
+
+    w->done = 1;
+    i0_log(w->status ? I0_LOG_BAD : I0_LOG_GOOD, i0_lang[I0_LANG_WAIT_EXITED], w->task, w->status);
 }
 
-#define i0_task_find_and_do(task, thing) do { \
-    i0_string path; \
-    i0_task_find(task, path); \
-    thing(task, path); \
-} while (0)
+static int i0_wait(const int argc, const char* argv[]) {
+    int ready = 0;
+    int any = 0;
+    long timeout = -1;
+
+    i0_waiter* waiters = calloc((size_t)argc + 1, sizeof(*waiters));
+    if (!waiters) i0_perror("calloc()");
+    size_t n = 0;
+
+    for (int i = 0; i < argc; i++) {
+        if (str_eq(argv[i], "--ready")) ready = 1;
+        else if (str_eq(argv[i], "--exit")) ready = 0;
+        else if (str_eq(argv[i], "--any")) any = 1;
+        else if (str_eq(argv[i], "--all")) any = 0;
+        else if (str_eq(argv[i], "--timeout")) {
+            if (++i == argc || (timeout = strtol(argv[i], NULL, 10)) < 0) {
+                i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_WAIT_BAD_TIMEOUT]);
+            }
+        }
+        else {
+            i0_waiter* w = &waiters[n++];
+            w->task = argv[i];
+            i0_task_find(w->task, w->dir);
+            i0_get_task_pid_file(w->pid_path, w->task);
+        }
+    }
+
+    if (n == 0) {
+        i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_ERROR_NO_WAIT_ARG]);
+    }
+
+    // every start, ready and exit is appended to the journal, so its dir
+    // changing is the one thing worth waking up for
+    i0_string events;
+    i0_get_events_dir(events);
+    try_mkdir_p(events);
+    const int ino = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (ino < 0 || inotify_add_watch(ino, events, IN_MODIFY | IN_CREATE | IN_MOVED_TO) < 0) {
+        i0_perror("inotify");
+    }
+
+    struct pollfd* pfd = calloc(n + 1, sizeof(*pfd));
+    if (!pfd) i0_perror("calloc()");
+
+    const int64_t deadline = timeout < 0 ? 0 : i0_clock_ns(CLOCK_MONOTONIC) + (int64_t)timeout * 1000000000;
+    for (size_t i = 0; i < n; i++) {
+        waiters[i].deadline = deadline;
+        i0_waiter_start(&waiters[i], ready);
+    }
+    const i0_waiter* first = NULL;
+
+    for (;;) {
+        const int64_t now = i0_clock_ns(CLOCK_MONOTONIC);
+        size_t done = 0;
+        int poll_ms = -1;
+
+        for (size_t i = 0; i < n; i++) {
+            i0_waiter* w = &waiters[i];
+            i0_waiter_check(w, ready, now);
+            if (w->done && !first) first = w;
+            done += (size_t)w->done;
+
+            if (w->done) continue;
+            if (w->exited) poll_ms = 10; // waiting for the supervisor to write it down
+            if (w->pid && !w->exited && w->pidfd < 0) poll_ms = 100;
+            if (ready && w->check_at) {
+                const int at = w->check_at > now ? (int)((w->check_at - now) / 1000000) + 1 : 0;
+                if (poll_ms < 0 || at < poll_ms) poll_ms = at;
+            }
+        }
+
+        if (done == n || (any && first)) break;
+
+        if (deadline) {
+            if (now >= deadline) {
+                i0_log(I0_LOG_WARNING, "%s", i0_lang[I0_LANG_WAIT_TIMEOUT]);
+                return I0_WAIT_TIMEOUT_STATUS;
+            }
+            const int left = (int)((deadline - now) / 1000000) + 1;
+            if (poll_ms < 0 || left < poll_ms) poll_ms = left;
+        }
+
+        pfd[0] = (struct pollfd){ .fd = ino, .events = POLLIN };
+        for (size_t i = 0; i < n; i++) {
+            pfd[i + 1] = (struct pollfd){ .fd = waiters[i].pidfd, .events = POLLIN };
+        }
+        if (poll(pfd, n + 1, poll_ms) < 0 && errno != EINTR) {
+            i0_perror("poll()");
+        }
+
+        char buf[4096];
+        while (read(ino, buf, sizeof(buf)) > 0) ;
+
+        for (size_t i = 0; i < n; i++) {
+            if (!(pfd[i + 1].revents & POLLIN)) continue;
+            close(waiters[i].pidfd);
+            waiters[i].pidfd = -1;
+            waiters[i].exited = 1;
+        }
+    }
+
+    if (any) return first->status;
+    for (size_t i = 0; i < n; i++) {
+        if (waiters[i].status) return waiters[i].status;
+    }
+    return EXIT_SUCCESS;
+}
 
 int main(const int argc, const char* argv[]) {
     i0_get_lang();
+    i0_log_init();
 
     if (argc < 2) {
         i0_log(I0_LOG_CRITICAL, i0_lang[I0_LANG_ERROR_NO_ARGS], argv[0]);
@@ -792,35 +4567,61 @@ int main(const int argc, const char* argv[]) {
         if (geteuid() != 0) {
             i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_ERROR_BOOT_NO_PERMISSION]);
         }
+        // pid 1 must never exit, so it stays around as the supervisor
+        if (getpid() == 1) i0_supervise(-1, -1);
         i0_boot();
     }
 
+    if (str_eq(argv[1], "supervise")) {
+        if (argc == 5 && str_eq(argv[2], "--resume")) {
+            i0_supervise(atoi(argv[3]), atoi(argv[4]));
+        }
+        i0_supervise(-1, -1);
+    }
+
+    if (str_eq(argv[1], "reexec")) {
+        return i0_reexec();
+    }
+
     if (str_eq(argv[1], "new")) {
-        i0_task_new();
+        i0_task_new(argc - 2, argv + 2);
+    }
+
+    if (str_eq(argv[1], "import")) {
+        return i0_import(argc - 2, argv + 2);
     }
 
     if (str_eq(argv[1], "start")) {
-        if (argc < 3) {
-            i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_ERROR_NO_START_ARG]);
-        }
-        i0_task_find_and_do(argv[2], i0_task_start_script);
-        return EXIT_SUCCESS;
+        return i0_batch_main(argc - 2, argv + 2, i0_task_start_script, I0_LANG_ERROR_NO_START_ARG);
     }
 
     if (str_eq(argv[1], "stop")) {
-        if (argc < 3) {
-            i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_ERROR_NO_STOP_ARG]);
-        }
-        i0_task_find_and_do(argv[2], i0_task_stop_script);
+        return i0_batch_main(argc - 2, argv + 2, i0_task_stop_script, I0_LANG_ERROR_NO_STOP_ARG);
+    }
+
+    if (str_eq(argv[1], "restart")) {
+        return i0_batch_main(argc - 2, argv + 2, i0_task_restart_script, I0_LANG_ERROR_NO_RESTART_ARG);
+    }
+
+    if (str_eq(argv[1], "wait")) {
+        return i0_wait(argc - 2, argv + 2);
+    }
+
+    if (str_eq(argv[1], "fdstore")) {
+        return i0_fdstore(argc - 2, argv + 2);
+    }
+
+    if (str_eq(argv[1], "log")) {
+        return i0_log_command(argc - 2, argv + 2);
+    }
+
+    if (str_eq(argv[1], "events")) {
+        i0_events(argc - 2, argv + 2);
         return EXIT_SUCCESS;
     }
 
     if (str_eq(argv[1], "status")) {
-        if (argc < 3) {
-            i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_ERROR_NO_STATUS_ARG]);
-        }
-        i0_task_find_and_do(argv[2], i0_task_status_script);
-        return EXIT_SUCCESS;
+        return i0_batch_main(argc - 2, argv + 2, i0_task_status_script, I0_LANG_ERROR_NO_STATUS_ARG);
     }
 
     i0_log(I0_LOG_CRITICAL, "%s", i0_lang[I0_LANG_ERROR_UNKNOWN_COMMAND]);
@@ -8,16 +8,26 @@
 static void io_lang_use_en() {
     i0_lang[I0_LANG_ERROR_NO_ARGS] = "error: no arguments provided. try '%s help'";
     i0_lang[I0_LANG_ERROR_UNKNOWN_COMMAND] = "error: unknown command";
+    i0_lang[I0_LANG_ERROR_UNKNOWN_OPTION] = "error: unknown option %s";
     i0_lang[I0_LANG_ERROR_BOOT_NO_PERMISSION] = "error: 'boot' must be run as root";
     i0_lang[I0_LANG_ERROR_NO_START_ARG] = "error: nothing to start";
     i0_lang[I0_LANG_ERROR_NO_STOP_ARG] = "error: nothing to stop";
     i0_lang[I0_LANG_ERROR_NO_STATUS_ARG] = "error: nothing to status";
+    i0_lang[I0_LANG_ERROR_NO_RESTART_ARG] = "error: nothing to restart";
+    i0_lang[I0_LANG_ERROR_NO_WAIT_ARG] = "error: nothing to wait for";
     i0_lang[I0_LANG_ERROR_TASK_NOT_FOUND] = "error: task not found";
     i0_lang[I0_LANG_ERROR_DIRECTORY_NOT_FOUND] = "error: directory does not exist: %s";
     i0_lang[I0_LANG_ERROR_MAIN_NOT_FOUND] = "error: main script not found";
     i0_lang[I0_LANG_ERROR_BUFFER_OVERFLOW] = "error: buffer overflow";
     i0_lang[I0_LANG_ERROR_NO_HOME] = "error: HOME environment variable is not set";
+    i0_lang[I0_LANG_ERROR_NO_RUNTIME_DIR] = "error: no runtime dir, set $XDG_RUNTIME_DIR";
     i0_lang[I0_LANG_ERROR_START_FAIL] = "error: start script failed";
+    i0_lang[I0_LANG_ERROR_STOP_FAIL] = "error: stop script failed";
+    i0_lang[I0_LANG_ERROR_STATUS_FAIL] = "error: status script failed";
+    i0_lang[I0_LANG_ERROR_TASK_BUSY] = "error: %s is still busy after %ld seconds";
+    i0_lang[I0_LANG_SCRIPT_TIMEOUT] = "%s timed out after %ld seconds and was killed";
+    i0_lang[I0_LANG_ERROR_EVENTS_WRITE] = "error: cannot write event journal: %s";
+    i0_lang[I0_LANG_ERROR_EVENTS_BAD_SINCE] = "error: bad --since value, expected seconds, <N>s/m/h/d or YYYY-MM-DD [HH:MM:SS]";
 
     i0_lang[I0_LANG_IO_Y_UPPERCASE] = "Y";
     i0_lang[I0_LANG_IO_Y_LOWERCASE] = "y";
@@ -35,6 +45,14 @@ static void io_lang_use_en() {
     i0_lang[I0_LANG_NEW_STOP] = "Make stop template script?";
     i0_lang[I0_LANG_NEW_PATH_TOO_LONG] = "Path name too long";
     i0_lang[I0_LANG_NEW_TASK_CREATED] = "successfully created task at %s";
+    i0_lang[I0_LANG_NEW_USAGE] = "usage: i0 new [--name <task> --command <command> [--description <text>] [--enabled] [--start] [--stop] [--status] [--force]]";
+    i0_lang[I0_LANG_NEW_BAD_NAME] = "bad name: %s";
+    i0_lang[I0_LANG_NEW_TASK_EXISTS] = "task already exists at %s, pass --force to replace it";
+    i0_lang[I0_LANG_IMPORT_USAGE] = "usage: i0 import <manifest>";
+    i0_lang[I0_LANG_IMPORT_BAD_LINE] = "%s:%zu: expected [task] or key = value";
+    i0_lang[I0_LANG_IMPORT_BAD_SCRIPT] = "%s:%zu: unknown script %s";
+    i0_lang[I0_LANG_IMPORT_NO_COMMAND] = "%s: task %s has no command";
+    i0_lang[I0_LANG_IMPORT_DONE] = "imported %zu tasks into %s";
 
     i0_lang[I0_LANG_STATUS_STARTED] = "started %s";
     i0_lang[I0_LANG_STATUS_STOPPED] = "stopped %s";
@@ -46,7 +64,47 @@ static void io_lang_use_en() {
     i0_lang[I0_LANG_STATUS_STARTED_AT] = "started at: %s";
     i0_lang[I0_LANG_STATUS_ALREADY_STOPPED] = "already stopped";
     i0_lang[I0_LANG_STATUS_ALREADY_RUNNING] = "already running with PID %s";
+    i0_lang[I0_LANG_STATUS_LAST_EXIT] = "last exit status: %ld";
 
     i0_lang[I0_LANG_BOOT_START] = "starting boot sequence";
     i0_lang[I0_LANG_BOOT_END] = "boot sequence ended";
+    i0_lang[I0_LANG_SUPERVISE_START] = "supervisor started";
+    i0_lang[I0_LANG_SUPERVISE_END] = "supervisor stopped";
+    i0_lang[I0_LANG_SUPERVISE_EXITED] = "%s exited with status %d";
+    i0_lang[I0_LANG_SUPERVISE_KILLED] = "%s killed by signal %d";
+    i0_lang[I0_LANG_SUPERVISE_ADOPTED] = "%s daemonized, now tracking PID %d";
+    i0_lang[I0_LANG_PSI_SHED] = "memory pressure, stopping %s";
+    i0_lang[I0_LANG_PSI_FREEZE] = "memory pressure, freezing %s";
+    i0_lang[I0_LANG_PSI_RESTORE] = "memory pressure is gone, bringing back %s";
+    i0_lang[I0_LANG_PSI_ARM_FAILED] = "can not watch memory pressure in %s: %s";
+    i0_lang[I0_LANG_BATCH_NOT_FOUND] = "task not found: %s";
+    i0_lang[I0_LANG_BATCH_BAD_JOBS] = "error: -j expects a positive number";
+    i0_lang[I0_LANG_BATCH_TASK] = "%s:";
+    i0_lang[I0_LANG_BATCH_OK] = "%s: ok";
+    i0_lang[I0_LANG_BATCH_FAILED] = "%s: failed";
+    i0_lang[I0_LANG_GROUP_QUEUED] = "%s waits, group %s is full";
+    i0_lang[I0_LANG_GROUP_BAD_LIMIT] = "group %s: limits below 1 count as 1";
+    i0_lang[I0_LANG_HANDOVER_DONE] = "handed %s over to PID %s";
+    i0_lang[I0_LANG_HANDOVER_FAILED] = "new %s never became ready, PID %d keeps running";
+    i0_lang[I0_LANG_FDSTORE_USAGE] = "usage: i0 fdstore <name> <fd> | i0 fdstore --remove <name>";
+    i0_lang[I0_LANG_LOG_USAGE] = "usage: i0 log <info|good|bad|start|stop|warning|critical> <message>";
+    i0_lang[I0_LANG_FDSTORE_NO_SUPERVISOR] = "error: no supervisor is running";
+    i0_lang[I0_LANG_FDSTORE_REFUSED] = "error: supervisor refused the request";
+    i0_lang[I0_LANG_FDSTORE_STORED] = "stored fd %s of %s";
+    i0_lang[I0_LANG_REEXEC_START] = "re-executing %s";
+    i0_lang[I0_LANG_REEXEC_FAILED] = "cannot re-execute %s: %s";
+    i0_lang[I0_LANG_REEXEC_RESUMED] = "supervisor resumed, %s";
+    i0_lang[I0_LANG_REEXEC_BAD_STATE] = "cannot read the saved supervisor state, starting without it";
+    i0_lang[I0_LANG_REEXEC_REFUSED] = "supervisor could not re-execute, it keeps running as before";
+    i0_lang[I0_LANG_REEXEC_DONE] = "supervisor re-executed";
+    i0_lang[I0_LANG_WATCH_TRIGGERED] = "%s triggered by %s";
+    i0_lang[I0_LANG_WATCH_FAILED] = "%s: cannot watch %s: %s";
+    i0_lang[I0_LANG_WATCH_BAD_EVENT] = "%s: unknown watch event %s";
+    i0_lang[I0_LANG_IDLE_STOP] = "%s was idle for %ld seconds, stopping it";
+    i0_lang[I0_LANG_WAIT_READY] = "%s is ready";
+    i0_lang[I0_LANG_WAIT_EXITED] = "%s exited with status %d";
+    i0_lang[I0_LANG_WAIT_NOT_READY] = "%s exited with status %d before it was ready";
+    i0_lang[I0_LANG_WAIT_UNKNOWN] = "%s exited, but no supervisor recorded its status";
+    i0_lang[I0_LANG_WAIT_TIMEOUT] = "timed out";
+    i0_lang[I0_LANG_WAIT_BAD_TIMEOUT] = "error: --timeout expects seconds";
 }
\ No newline at end of file
@@ -6,16 +6,26 @@
 enum {
     I0_LANG_ERROR_NO_ARGS = 0,
     I0_LANG_ERROR_UNKNOWN_COMMAND,
+    I0_LANG_ERROR_UNKNOWN_OPTION,
     I0_LANG_ERROR_BOOT_NO_PERMISSION,
     I0_LANG_ERROR_NO_START_ARG,
     I0_LANG_ERROR_NO_STOP_ARG,
     I0_LANG_ERROR_NO_STATUS_ARG,
+    I0_LANG_ERROR_NO_RESTART_ARG,
+    I0_LANG_ERROR_NO_WAIT_ARG,
     I0_LANG_ERROR_TASK_NOT_FOUND,
     I0_LANG_ERROR_DIRECTORY_NOT_FOUND,
     I0_LANG_ERROR_MAIN_NOT_FOUND,
     I0_LANG_ERROR_BUFFER_OVERFLOW,
     I0_LANG_ERROR_NO_HOME,
+    I0_LANG_ERROR_NO_RUNTIME_DIR,
     I0_LANG_ERROR_START_FAIL,
+    I0_LANG_ERROR_STOP_FAIL,
+    I0_LANG_ERROR_STATUS_FAIL,
+    I0_LANG_ERROR_TASK_BUSY,
+    I0_LANG_SCRIPT_TIMEOUT,
+    I0_LANG_ERROR_EVENTS_WRITE,
+    I0_LANG_ERROR_EVENTS_BAD_SINCE,
 
     I0_LANG_IO_Y_UPPERCASE,
     I0_LANG_IO_Y_LOWERCASE,
@@ -33,6 +43,14 @@ enum {
     I0_LANG_NEW_STOP,
     I0_LANG_NEW_PATH_TOO_LONG,
     I0_LANG_NEW_TASK_CREATED,
+    I0_LANG_NEW_USAGE,
+    I0_LANG_NEW_BAD_NAME,
+    I0_LANG_NEW_TASK_EXISTS,
+    I0_LANG_IMPORT_USAGE,
+    I0_LANG_IMPORT_BAD_LINE,
+    I0_LANG_IMPORT_BAD_SCRIPT,
+    I0_LANG_IMPORT_NO_COMMAND,
+    I0_LANG_IMPORT_DONE,
 
     I0_LANG_STATUS_STARTED,
     I0_LANG_STATUS_STOPPED,
@@ -44,9 +62,49 @@ enum {
     I0_LANG_STATUS_STARTED_AT,
     I0_LANG_STATUS_ALREADY_STOPPED,
     I0_LANG_STATUS_ALREADY_RUNNING,
+    I0_LANG_STATUS_LAST_EXIT,
 
     I0_LANG_BOOT_START,
     I0_LANG_BOOT_END,
+    I0_LANG_SUPERVISE_START,
+    I0_LANG_SUPERVISE_END,
+    I0_LANG_SUPERVISE_EXITED,
+    I0_LANG_SUPERVISE_KILLED,
+    I0_LANG_SUPERVISE_ADOPTED,
+    I0_LANG_PSI_SHED,
+    I0_LANG_PSI_FREEZE,
+    I0_LANG_PSI_RESTORE,
+    I0_LANG_PSI_ARM_FAILED,
+    I0_LANG_BATCH_NOT_FOUND,
+    I0_LANG_BATCH_BAD_JOBS,
+    I0_LANG_BATCH_TASK,
+    I0_LANG_BATCH_OK,
+    I0_LANG_BATCH_FAILED,
+    I0_LANG_GROUP_QUEUED,
+    I0_LANG_GROUP_BAD_LIMIT,
+    I0_LANG_HANDOVER_DONE,
+    I0_LANG_HANDOVER_FAILED,
+    I0_LANG_FDSTORE_USAGE,
+    I0_LANG_LOG_USAGE,
+    I0_LANG_FDSTORE_NO_SUPERVISOR,
+    I0_LANG_FDSTORE_REFUSED,
+    I0_LANG_FDSTORE_STORED,
+    I0_LANG_REEXEC_START,
+    I0_LANG_REEXEC_FAILED,
+    I0_LANG_REEXEC_RESUMED,
+    I0_LANG_REEXEC_BAD_STATE,
+    I0_LANG_REEXEC_REFUSED,
+    I0_LANG_REEXEC_DONE,
+    I0_LANG_WATCH_TRIGGERED,
+    I0_LANG_WATCH_FAILED,
+    I0_LANG_WATCH_BAD_EVENT,
+    I0_LANG_IDLE_STOP,
+    I0_LANG_WAIT_READY,
+    I0_LANG_WAIT_EXITED,
+    I0_LANG_WAIT_NOT_READY,
+    I0_LANG_WAIT_UNKNOWN,
+    I0_LANG_WAIT_TIMEOUT,
+    I0_LANG_WAIT_BAD_TIMEOUT,
 
     I0_LANG_COUNT
 };
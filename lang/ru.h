@@ -8,16 +8,26 @@
 static void io_lang_use_ru() {
     i0_lang[I0_LANG_ERROR_NO_ARGS] = "ошибка: аргументы не указаны. попробуйте '%s help'";
     i0_lang[I0_LANG_ERROR_UNKNOWN_COMMAND] = "ошибка: неизвестная команда";
+    i0_lang[I0_LANG_ERROR_UNKNOWN_OPTION] = "ошибка: неизвестный параметр %s";
     i0_lang[I0_LANG_ERROR_BOOT_NO_PERMISSION] = "ошибка: 'boot' доступен только суперпользователю";
     i0_lang[I0_LANG_ERROR_NO_START_ARG] = "ошибка: нечего запускать";
     i0_lang[I0_LANG_ERROR_NO_STOP_ARG] = "ошибка: нечего завершать";
     i0_lang[I0_LANG_ERROR_NO_STATUS_ARG] = "ошибка: нечего проверять";
+    i0_lang[I0_LANG_ERROR_NO_RESTART_ARG] = "ошибка: нечего перезапускать";
+    i0_lang[I0_LANG_ERROR_NO_WAIT_ARG] = "ошибка: нечего ждать";
     i0_lang[I0_LANG_ERROR_TASK_NOT_FOUND] = "ошибка: задача не найдена";
     i0_lang[I0_LANG_ERROR_DIRECTORY_NOT_FOUND] = "ошибка: директория не найдена";
     i0_lang[I0_LANG_ERROR_MAIN_NOT_FOUND] = "ошибка: main скрипт не найден";
     i0_lang[I0_LANG_ERROR_BUFFER_OVERFLOW] = "ошибка: переполнение буфера";
     i0_lang[I0_LANG_ERROR_NO_HOME] = "ошибка: переменная окружения HOME не установлена";
+    i0_lang[I0_LANG_ERROR_NO_RUNTIME_DIR] = "ошибка: нет каталога для временных файлов, задайте $XDG_RUNTIME_DIR";
     i0_lang[I0_LANG_ERROR_START_FAIL] = "ошибка: не удалось запустить start скрипт";
+    i0_lang[I0_LANG_ERROR_STOP_FAIL] = "ошибка: не удалось запустить stop скрипт";
+    i0_lang[I0_LANG_ERROR_STATUS_FAIL] = "ошибка: не удалось запустить status скрипт";
+    i0_lang[I0_LANG_ERROR_TASK_BUSY] = "ошибка: %s всё ещё занята через %ld секунд";
+    i0_lang[I0_LANG_SCRIPT_TIMEOUT] = "%s не завершился за %ld секунд и был убит";
+    i0_lang[I0_LANG_ERROR_EVENTS_WRITE] = "ошибка: не удалось записать журнал событий: %s";
+    i0_lang[I0_LANG_ERROR_EVENTS_BAD_SINCE] = "ошибка: неверное значение --since, ожидаются секунды, <N>s/m/h/d или YYYY-MM-DD [HH:MM:SS]";
 
     i0_lang[I0_LANG_IO_Y_UPPERCASE] = "Д";
     i0_lang[I0_LANG_IO_Y_LOWERCASE] = "д";
@@ -35,6 +45,14 @@ static void io_lang_use_ru() {
     i0_lang[I0_LANG_NEW_STOP] = "Сделать шаблон stop?";
     i0_lang[I0_LANG_NEW_PATH_TOO_LONG] = "Слишком длинный путь";
     i0_lang[I0_LANG_NEW_TASK_CREATED] = "задача успешно создана по пути %s";
+    i0_lang[I0_LANG_NEW_USAGE] = "использование: i0 new [--name <задача> --command <команда> [--description <текст>] [--enabled] [--start] [--stop] [--status] [--force]]";
+    i0_lang[I0_LANG_NEW_BAD_NAME] = "недопустимое имя: %s";
+    i0_lang[I0_LANG_NEW_TASK_EXISTS] = "задача уже существует в %s, укажите --force чтобы заменить её";
+    i0_lang[I0_LANG_IMPORT_USAGE] = "использование: i0 import <манифест>";
+    i0_lang[I0_LANG_IMPORT_BAD_LINE] = "%s:%zu: ожидалось [задача] или ключ = значение";
+    i0_lang[I0_LANG_IMPORT_BAD_SCRIPT] = "%s:%zu: неизвестный скрипт %s";
+    i0_lang[I0_LANG_IMPORT_NO_COMMAND] = "%s: у задачи %s нет команды";
+    i0_lang[I0_LANG_IMPORT_DONE] = "импортировано задач: %zu в %s";
 
     i0_lang[I0_LANG_STATUS_STARTED] = "запущена задача %s";
     i0_lang[I0_LANG_STATUS_STOPPED] = "остановлена задача %s";
@@ -46,7 +64,47 @@ static void io_lang_use_ru() {
     i0_lang[I0_LANG_STATUS_STARTED_AT] = "запущено в";
     i0_lang[I0_LANG_STATUS_ALREADY_STOPPED] = "уже остановлено";
     i0_lang[I0_LANG_STATUS_ALREADY_RUNNING] = "уже запущено с PID %s";
+    i0_lang[I0_LANG_STATUS_LAST_EXIT] = "последний код выхода: %ld";
 
     i0_lang[I0_LANG_BOOT_START] = "загрузка начата";
     i0_lang[I0_LANG_BOOT_END] = "загрузка завершена";
+    i0_lang[I0_LANG_SUPERVISE_START] = "супервизор запущен";
+    i0_lang[I0_LANG_SUPERVISE_END] = "супервизор остановлен";
+    i0_lang[I0_LANG_SUPERVISE_EXITED] = "%s завершилась с кодом %d";
+    i0_lang[I0_LANG_SUPERVISE_KILLED] = "%s убита сигналом %d";
+    i0_lang[I0_LANG_SUPERVISE_ADOPTED] = "%s ушла в фон, теперь отслеживается PID %d";
+    i0_lang[I0_LANG_PSI_SHED] = "нехватка памяти, останавливается %s";
+    i0_lang[I0_LANG_PSI_FREEZE] = "нехватка памяти, замораживается %s";
+    i0_lang[I0_LANG_PSI_RESTORE] = "нехватка памяти прошла, возвращается %s";
+    i0_lang[I0_LANG_PSI_ARM_FAILED] = "не удалось следить за нагрузкой на память в %s: %s";
+    i0_lang[I0_LANG_BATCH_NOT_FOUND] = "задача не найдена: %s";
+    i0_lang[I0_LANG_BATCH_BAD_JOBS] = "ошибка: -j ожидает положительное число";
+    i0_lang[I0_LANG_BATCH_TASK] = "%s:";
+    i0_lang[I0_LANG_BATCH_OK] = "%s: успешно";
+    i0_lang[I0_LANG_BATCH_FAILED] = "%s: ошибка";
+    i0_lang[I0_LANG_GROUP_QUEUED] = "%s ждёт, группа %s заполнена";
+    i0_lang[I0_LANG_GROUP_BAD_LIMIT] = "группа %s: ограничения меньше 1 считаются за 1";
+    i0_lang[I0_LANG_HANDOVER_DONE] = "%s передана PID %s";
+    i0_lang[I0_LANG_HANDOVER_FAILED] = "новая %s так и не стала готова, PID %d продолжает работу";
+    i0_lang[I0_LANG_FDSTORE_USAGE] = "использование: i0 fdstore <имя> <fd> | i0 fdstore --remove <имя>";
+    i0_lang[I0_LANG_LOG_USAGE] = "использование: i0 log <info|good|bad|start|stop|warning|critical> <сообщение>";
+    i0_lang[I0_LANG_FDSTORE_NO_SUPERVISOR] = "ошибка: супервизор не запущен";
+    i0_lang[I0_LANG_FDSTORE_REFUSED] = "ошибка: супервизор отклонил запрос";
+    i0_lang[I0_LANG_FDSTORE_STORED] = "сохранён fd %s задачи %s";
+    i0_lang[I0_LANG_REEXEC_START] = "перезапуск %s";
+    i0_lang[I0_LANG_REEXEC_FAILED] = "не удалось перезапустить %s: %s";
+    i0_lang[I0_LANG_REEXEC_RESUMED] = "супервизор продолжил работу, %s";
+    i0_lang[I0_LANG_REEXEC_BAD_STATE] = "не удалось прочитать сохранённое состояние супервизора, запуск без него";
+    i0_lang[I0_LANG_REEXEC_REFUSED] = "супервизор не смог перезапуститься и работает как раньше";
+    i0_lang[I0_LANG_REEXEC_DONE] = "супервизор перезапущен";
+    i0_lang[I0_LANG_WATCH_TRIGGERED] = "%s запущена из-за %s";
+    i0_lang[I0_LANG_WATCH_FAILED] = "%s: не удалось следить за %s: %s";
+    i0_lang[I0_LANG_WATCH_BAD_EVENT] = "%s: неизвестное событие %s";
+    i0_lang[I0_LANG_IDLE_STOP] = "%s простаивала %ld секунд, остановка";
+    i0_lang[I0_LANG_WAIT_READY] = "%s готова";
+    i0_lang[I0_LANG_WAIT_EXITED] = "%s завершилась с кодом %d";
+    i0_lang[I0_LANG_WAIT_NOT_READY] = "%s завершилась с кодом %d, не дождавшись готовности";
+    i0_lang[I0_LANG_WAIT_UNKNOWN] = "%s завершилась, но её статус не записан супервизором";
+    i0_lang[I0_LANG_WAIT_TIMEOUT] = "время ожидания истекло";
+    i0_lang[I0_LANG_WAIT_BAD_TIMEOUT] = "ошибка: --timeout ожидает секунды";
 }